@@ -1,14 +1,14 @@
 /*************************  AlignedArray.cpp  *********************************
 * Author:        Agner Fog
 * Date created:  2008-06-12
-* Last modified: 2022-08-05
+* Last modified: 2026-10-19
 * Description:
 * Defines linear array of dynamic size.
-* First entry is aligned at address divisible by 16
+* First entry is aligned at address divisible by ALIGNBY (default 16)
 *
 * The latest version of this file is available at:
 * www.agner.org/optimize/cppexamples.zip
-* (c) 2008-2022 GNU General Public License www.gnu.org/copyleft/gpl.html
+* (c) 2008-2026 GNU General Public License www.gnu.org/copyleft/gpl.html
 *******************************************************************************
 *
 * Note: This code is not needed when compiling for C++98 or later because
@@ -17,10 +17,25 @@
 * 
 * AlignedArray is a container class defining a dynamic array or memory pool 
 * that can contain any number of objects of the same type. The beginning of
-* the array is aligned at a memory address divisible by 16. This is useful
-* when using the intrinsic vector types __m128 or bigger.
+* the array is aligned at a memory address divisible by the template
+* parameter ALIGNBY, which must be a power of 2. The default is 16, which is
+* sufficient for __m128. Use 32 for __m256, 64 for __m512 or to align by
+* cache lines, or 4096 to align by memory pages.
 *
 * Array elements can be accessed one by one, or grouped together into vectors.
+* Vect<VEC>(i) gives the vector starting at index i. ForEachVector<VEC>(f)
+* calls the function object f for every vector in the array. The size of the
+* buffer is rounded up to a multiple of ALIGNBY, so that the last vector can
+* be read and written as a whole vector even if it is only partially used.
+* This avoids the extra code for the remaining elements in vector loops.
+*
+* Big buffers of MAPTHRESHOLD bytes or more are allocated with mmap on Linux.
+* Such a buffer is made bigger with mremap, which moves the memory pages to a
+* new virtual address without copying any data. Increasing the size of a big
+* array is therefore fast, and the peak memory use is not doubled during the
+* re-allocation. Pages that have never been written to use no physical
+* memory. Set HUGEPAGES to 1 to ask for transparent huge pages for these
+* buffers, which reduces TLB misses. Set MAPTHRESHOLD to 0 to always use new.
 *
 * The objects stored can be of any type that does not require a constructor
 * or destructor. The size of the memory pool can grow, but not shrink.
@@ -61,11 +76,23 @@ Header part. Put this in a .h file:
 #include <stdlib.h>                              // For exit in Error function
 #include <stdio.h>                               // Needed for example only
 #include <xmmintrin.h>                           // Needed for example only
+#include <immintrin.h>                           // Needed for example only
+#include <time.h>                                // Needed for example only
+#if defined(__linux__)
+#include <sys/mman.h>                            // For mmap and mremap
+#include <unistd.h>                              // For sysconf
+#endif
 
 #define BOUNDSCHECKING 1                         // 0 will skip array bounds checking
+#ifndef MAPTHRESHOLD
+#define MAPTHRESHOLD  (1 << 21)                  // Buffers of this size or bigger are allocated with mmap on Linux. 0 = never
+#endif
+#ifndef HUGEPAGES
+#define HUGEPAGES     0                          // 1 will use transparent huge pages for buffers allocated with mmap
+#endif
 
 // Class AlignedArray makes an aligned dynamic array
-template <typename TX>
+template <typename TX, int ALIGNBY = 16>
 class AlignedArray {
 public:
    // Constructor
@@ -91,19 +118,41 @@ public:
    VEC & Vect(int i) {
       const int ElementsPerVector = sizeof(VEC) / sizeof(TX);// Number of elements per vector
 #if BOUNDSCHECKING
+      if (sizeof(VEC) > AlignBy) {Error(4, sizeof(VEC)); i = 0;} // Vector size bigger than alignment
       if (i & (ElementsPerVector-1)) {Error(2, i); i = 0;} // Index i not divisible by vector size
       if ((unsigned int)(ElementsPerVector - 1 + i) >= (unsigned int)NumEntries) {Error(1, i);  i = 0;}  // Index i out of range
 #endif
       return *(VEC*)(bufferA + i);
    }
+   // Call f(VEC & v, int n) for each vector v in the array, where n is the
+   // number of valid elements in v. n is less than the vector size only in
+   // the last vector. The unused elements of the last vector are set to zero
+   // before f is called. f may modify them. FUNC can be a function object
+   // or a function pointer.
+   template <typename VEC, typename FUNC>
+   void ForEachVector(FUNC f) {
+      const int ElementsPerVector = sizeof(VEC) / sizeof(TX);// Number of elements per vector
+      if (sizeof(VEC) > AlignBy || sizeof(VEC) % sizeof(TX)) {Error(4, sizeof(VEC)); return;}
+      int i;
+      for (i = 0; i + ElementsPerVector <= NumEntries; i += ElementsPerVector) {
+         f(*(VEC*)(bufferA + i), ElementsPerVector);
+      }
+      if (i < NumEntries) {
+         // Partial vector at the end. The buffer has space for a whole vector
+         memset(bufferA + NumEntries, 0, (i + ElementsPerVector - NumEntries) * sizeof(TX));
+         f(*(VEC*)(bufferA + i), NumEntries - i);
+      }
+   }
    // Define desired alignment. Must be a power of 2:
    enum DefineSize {
-      AlignBy = 16                               // Desired alignment, must be a power of 2
+      AlignBy = ALIGNBY                          // Desired alignment, must be a power of 2
    };
 private:
    char * bufferU;                               // Unaligned data buffer
    TX * bufferA;                                 // Aligned pointer to data buffer
    int MaxNum;                                   // Maximum number of objects that buffer can contain
+   size_t MappedSize;                            // Size of buffer if allocated with mmap, 0 if allocated with new
+   void ReserveMapped(int num);                  // Allocate or grow buffer with mmap or mremap
    AlignedArray(AlignedArray const&){};          // Make private copy constructor to prevent copying
    void operator = (AlignedArray const&){};      // Make private assignment operator to prevent copying
 protected:
@@ -113,23 +162,24 @@ protected:
 
 
 // Members of class AlignedArray
-template <typename TX>
-AlignedArray<TX>::AlignedArray() {  
+template <typename TX, int ALIGNBY>
+AlignedArray<TX, ALIGNBY>::AlignedArray() {  
    // Constructor
    bufferU = 0;  bufferA = 0;
    MaxNum = NumEntries = 0;
+   MappedSize = 0;
 }
 
 
-template <typename TX>
-AlignedArray<TX>::~AlignedArray() {
+template <typename TX, int ALIGNBY>
+AlignedArray<TX, ALIGNBY>::~AlignedArray() {
    // Destructor
    Reserve(0);                                   // De-allocate buffer
 }
 
 
-template <typename TX>
-void AlignedArray<TX>::Reserve(int num) {
+template <typename TX, int ALIGNBY>
+void AlignedArray<TX, ALIGNBY>::Reserve(int num) {
    // Allocate buffer for future growth to num objects.
    // Use this if it can be predicted that the size will be increased 
    // later with SetNum(num). This will minimize the number of
@@ -146,14 +196,26 @@ void AlignedArray<TX>::Reserve(int num) {
       if (num <= 0) {
          if (num < 0) Error(1, num);
          // num = 0. Discard data and de-allocate buffer
+#if defined(__linux__)
+         if (MappedSize) munmap(bufferU, MappedSize); // De-allocate buffer allocated with mmap
+         else
+#endif
          if (bufferU) delete[] bufferU;          // De-allocate buffer
          bufferU = 0;  bufferA = 0;
          MaxNum = NumEntries = 0;
+         MappedSize = 0;
          return;
       }
       // Request to reduce size. Ignore
       return;
    }
+#if defined(__linux__)
+   if (MAPTHRESHOLD > 0 && (size_t)num * sizeof(TX) >= (size_t)MAPTHRESHOLD && AlignBy <= 4096) {
+      // Big buffer. Use mmap. Pages are aligned by at least 4096
+      ReserveMapped(num);
+      return;
+   }
+#endif
    // num > MaxNum. Allocate new buffer
    char * buffer2U = 0;                          // New buffer, unaligned
    // Aligned pointer to new buffer:
@@ -164,7 +226,9 @@ void AlignedArray<TX>::Reserve(int num) {
    } buffer2A;
    // Note: On big-endian platforms buffer2A.i must have the same size as a pointer,
    // on little-endian platforms it doesn't matter.
-   buffer2U = new char[num*sizeof(TX)+AlignBy-1];// Allocate new buffer
+   // Size is rounded up to a multiple of AlignBy to make space for a whole last vector
+   size_t size = (num*sizeof(TX) + AlignBy - 1) & ~(size_t)(AlignBy - 1);
+   buffer2U = new char[size+AlignBy-1];          // Allocate new buffer
    if (buffer2U == 0) {Error(3,num); return;}    // Error can't allocate
    // Align new buffer by AlignBy (must be a power of 2)
    buffer2A.b = buffer2U + AlignBy - 1;
@@ -181,8 +245,42 @@ void AlignedArray<TX>::Reserve(int num) {
 }
 
 
-template <typename TX>
-void AlignedArray<TX>::SetNum(int num) {
+#if defined(__linux__)
+template <typename TX, int ALIGNBY>
+void AlignedArray<TX, ALIGNBY>::ReserveMapped(int num) {
+   // Allocate buffer with mmap, or make it bigger with mremap.
+   // mremap moves the memory pages by changing the page table, without
+   // copying the data.
+   size_t PageSize = (size_t)sysconf(_SC_PAGESIZE);
+   size_t NewSize = ((size_t)num * sizeof(TX) + PageSize - 1) & ~(PageSize - 1);
+   void * buffer2;                               // New buffer
+   if (MappedSize) {
+      // Buffer is already allocated with mmap. Grow it
+      buffer2 = mremap(bufferU, MappedSize, NewSize, MREMAP_MAYMOVE);
+   }
+   else {
+      // Buffer is allocated with new or not at all. Allocate new buffer and copy data.
+      // The new memory is zero
+      buffer2 = mmap(0, NewSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (buffer2 != MAP_FAILED && bufferA) {
+         memcpy(buffer2, bufferA, NumEntries*sizeof(TX));// Copy contents of old buffer into new one
+         delete[] bufferU;                       // De-allocate old buffer
+      }
+   }
+   if (buffer2 == MAP_FAILED) {Error(3,num); return;} // Error can't allocate
+#if HUGEPAGES
+   madvise(buffer2, NewSize, MADV_HUGEPAGE);     // Ask for transparent huge pages
+#endif
+   bufferU = (char*)buffer2;                     // Save pointer to buffer
+   bufferA = (TX*)buffer2;                       // Page aligned
+   MappedSize = NewSize;
+   MaxNum = num;                                 // Save new size
+}
+#endif
+
+
+template <typename TX, int ALIGNBY>
+void AlignedArray<TX, ALIGNBY>::SetNum(int num) {
    // Set the number of objects that are considered used and valid.
    // NumEntries is initially zero. It is increased by Push or SetNum
    // Setting num > NumEntries is equivalent to pushing (num - NumEntries)
@@ -210,14 +308,15 @@ void AlignedArray<TX>::SetNum(int num) {
 // Produce fatal error message. Used internally and by StringElement.
 // Note: If your program has a graphical user interface (GUI) then you
 // must rewrite this function to produce a message box with the error message.
-template <typename TX>
-void AlignedArray<TX>::Error(int e, int n) {
+template <typename TX, int ALIGNBY>
+void AlignedArray<TX, ALIGNBY>::Error(int e, int n) {
    // Define error texts
    static const char * ErrorTexts[] = {
       "Unknown error",                           // 0
       "Index out of range",                      // 1
       "Index not divisible by vector size",      // 2
-      "Memory allocation failed"                 // 3
+      "Memory allocation failed",                // 3
+      "Vector size bigger than alignment"        // 4
    };
    // Number of texts in ErrorTexts
    const unsigned int NumErrorTexts = sizeof(ErrorTexts) / sizeof(*ErrorTexts);
@@ -241,6 +340,49 @@ Example part. Remove this from final application:
 // To run this example, just compile this file for console mode and run it.
 // You may play with this example as you like
 
+// Kernels for ForEachVector, calculating v = v * scale + offset
+// for different vector sizes. The number of valid elements in v is not
+// needed, because the unused elements at the end of the buffer may be changed
+struct ScaleAdd32 {                              // One float at a time
+   float scale, offset;
+   ScaleAdd32(float s, float o) {scale = s;  offset = o;}
+   void operator () (float & v, int) {v = v * scale + offset;}
+};
+
+struct ScaleAdd128 {                             // Vectors of 4 floats
+   __m128 scale, offset;
+   ScaleAdd128(float s, float o) {scale = _mm_set1_ps(s);  offset = _mm_set1_ps(o);}
+   void operator () (__m128 & v, int) {v = _mm_add_ps(_mm_mul_ps(v, scale), offset);}
+};
+
+#ifdef __AVX__
+struct ScaleAdd256 {                             // Vectors of 8 floats
+   __m256 scale, offset;
+   ScaleAdd256(float s, float o) {scale = _mm256_set1_ps(s);  offset = _mm256_set1_ps(o);}
+   void operator () (__m256 & v, int) {v = _mm256_add_ps(_mm256_mul_ps(v, scale), offset);}
+};
+#endif
+
+#ifdef __AVX512F__
+struct ScaleAdd512 {                             // Vectors of 16 floats
+   __m512 scale, offset;
+   ScaleAdd512(float s, float o) {scale = _mm512_set1_ps(s);  offset = _mm512_set1_ps(o);}
+   void operator () (__m512 & v, int) {v = _mm512_add_ps(_mm512_mul_ps(v, scale), offset);}
+};
+#endif
+
+// Time the kernel on an array aligned by 64
+template <typename VEC, typename KERNEL>
+void Benchmark(AlignedArray<float, 64> & list, KERNEL kernel, const char * Name) {
+   const int Repeat = 2000;
+   clock_t start = clock();
+   for (int r = 0; r < Repeat; r++) {
+      list.template ForEachVector<VEC>(kernel);
+   }
+   double time = double(clock() - start) / CLOCKS_PER_SEC;
+   printf("\n%-8s %8.3f ns per element", Name, time * 1E9 / ((double)Repeat * list.GetNum()));
+}
+
 int main() {
    int i;                                        // Loop counter
 
@@ -272,5 +414,21 @@ int main() {
       printf("\n%2i:  %8.2f", i, list[i]);
    }
 
+   // Array aligned by 64 for vectors of any size.
+   // The size is not divisible by the vector size, so the last vector is partial
+   AlignedArray<float, 64> big;
+   big.SetNum(100003);
+
+   printf("\n\nScale and add kernel:");
+   Benchmark<float> (big, ScaleAdd32(0.5f, 1.0f),  "float");
+   Benchmark<__m128>(big, ScaleAdd128(0.5f, 1.0f), "__m128");
+#ifdef __AVX__
+   Benchmark<__m256>(big, ScaleAdd256(0.5f, 1.0f), "__m256");
+#endif
+#ifdef __AVX512F__
+   Benchmark<__m512>(big, ScaleAdd512(0.5f, 1.0f), "__m512");
+#endif
+   printf("\nLast element: %8.2f\n", big[big.GetNum()-1]);
+
    return 0;
 }
@@ -0,0 +1,443 @@
+/************************  ConcurrentQueue.cpp  *******************************
+* Author:        cppexamples contributors. Based on DynamicQueue by Agner Fog
+* Date created:  2026-10-19
+* Last modified: 2026-10-19
+* Description:
+* Defines First-In-First-Out queue for many producer and consumer threads.
+*
+* (c) 2026 GNU General Public License www.gnu.org/copyleft/gpl.html
+*******************************************************************************
+*
+* ConcurrentQueue is a container class defining a First-In-First-Out queue
+* that any number of threads can put objects into and get objects from at
+* the same time without a mutex.
+*
+* The objects stored can be of any type that does not require a constructor
+* or destructor, as in DynamicQueue.
+*
+* Unlike DynamicQueue, the size of ConcurrentQueue does not grow
+* automatically, because the buffer cannot be re-allocated while other
+* threads are using it. Use Reserve(n) to allocate space for n objects
+* before the queue is shared between threads. n is rounded up to a power
+* of 2.
+*
+* Each position in the buffer has a sequence number that tells whether the
+* position is free or contains an object, and for which round through the
+* buffer. A thread claims a position by incrementing the head or tail index
+* with compare-exchange, and then writes or reads the object and updates the
+* sequence number. Threads never wait for each other except when the queue
+* is full or empty. (This algorithm is by Dmitry Vyukov).
+*
+* TryPut and TryGet return false when the queue is full or empty. Put and
+* Get wait instead. They try a number of times and then go to sleep until
+* another thread has got or put an object. The sleeping uses a futex on
+* Linux, so that a waiting thread uses no CPU time, and the threads that
+* put and get objects make a system call only when other threads are
+* sleeping. Other systems yield the time slice instead.
+*
+* ConcurrentQueue requires C++11 (for <atomic> and <thread>).
+*
+* At the end of this file you will find a working example of how to use
+* ConcurrentQueue, including a scaling benchmark against DynamicQueue
+* protected by a mutex.
+*
+* The first part of this file containing declarations may be placed in a
+* header file. The second part containing examples should be removed from your
+* final application.
+*
+******************************************************************************/
+
+/******************************************************************************
+Header part. Put this in a .h file:
+******************************************************************************/
+
+#include <atomic>                                // For std::atomic
+#include <thread>                                // For std::this_thread::yield
+#include <stddef.h>                              // For size_t
+#include <stdint.h>                              // For intptr_t
+#include <stdlib.h>                              // For exit in Error function
+#include <stdio.h>                               // Needed for example only
+#if defined(__linux__)
+#include <linux/futex.h>                         // For futex wait and wake
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+// Class ConcurrentQueue makes a fixed size queue which can be used by many threads
+template <typename TX>
+class ConcurrentQueue {
+public:
+   ConcurrentQueue();                            // Constructor
+   ~ConcurrentQueue();                           // Destructor
+   void Reserve(int num);                        // Allocate buffer for num objects. Not thread safe
+   int GetNum();                                 // Get number of objects stored. Only approximate while other threads are active
+   int GetMaxNum(){return MaxNum;};              // Get number of objects that can be stored
+   bool TryPut(TX const & obj);                  // Add object to head of queue. Returns false if full
+   bool TryGet(TX & obj);                        // Take object out from tail of queue. Returns false if empty
+   void Put(TX const & obj);                     // Add object to head of queue. Waits while full
+   TX Get();                                     // Take object out from tail of queue. Waits while empty
+   enum DefineSize {
+      SpinCount = 32                             // Number of times Put and Get try before going to sleep
+   };
+private:
+   struct Cell {
+      std::atomic<size_t> Sequence;              // Position of next put if free, position + 1 if full
+      TX Data;                                   // Object stored
+   };
+   Cell * Buffer;                                // Buffer containing data
+   size_t Mask;                                  // MaxNum - 1
+   int MaxNum;                                   // Maximum number of objects
+   // Each index is on its own cache line to avoid false sharing
+   alignas(64) std::atomic<size_t> head;         // Position of next Put
+   alignas(64) std::atomic<size_t> tail;         // Position of next Get
+   alignas(64) std::atomic<int> PutEvents;       // Changed when an object is put while getters are waiting
+   std::atomic<int> GettersWaiting;              // Number of threads sleeping in Get
+   alignas(64) std::atomic<int> GetEvents;       // Changed when an object is got while putters are waiting
+   std::atomic<int> PuttersWaiting;              // Number of threads sleeping in Put
+   char Padding[64 - 2 * sizeof(std::atomic<int>)];  // Keep next object off this cache line
+   static void Wait(std::atomic<int> & event, int value); // Sleep while event == value
+   static void Wake(std::atomic<int> & event);   // Wake one thread waiting for event
+   void Error(int e, int n);                     // Make fatal error message
+   ConcurrentQueue(ConcurrentQueue const&){};    // Make private copy constructor to prevent copying
+   void operator = (ConcurrentQueue const&){};   // Make private assignment operator to prevent copying
+};
+
+
+// Members of class ConcurrentQueue
+template <typename TX>
+ConcurrentQueue<TX>::ConcurrentQueue() {
+   // Constructor
+   Buffer = 0;
+   Mask = 0;  MaxNum = 0;
+   head.store(0);  tail.store(0);
+   PutEvents.store(0);  GettersWaiting.store(0);
+   GetEvents.store(0);  PuttersWaiting.store(0);
+}
+
+
+template <typename TX>
+ConcurrentQueue<TX>::~ConcurrentQueue() {
+   // Destructor
+   Reserve(0);                                   // De-allocate buffer
+}
+
+
+template <typename TX>
+void ConcurrentQueue<TX>::Reserve(int num) {
+   // Allocate buffer of the specified size, rounded up to a power of 2.
+   // This must not be called while other threads are using the queue.
+   // Setting num > current MaxNum will allocate a larger buffer and
+   // move all data to the new buffer.
+   // Setting num <= current MaxNum will do nothing.
+   // Setting num = 0 will discard all data and de-allocate the buffer.
+   if (num <= MaxNum) {
+      if (num <= 0) {
+         if (num < 0) Error(1, num);
+         // num = 0. Discard data and de-allocate buffer
+         if (Buffer) delete[] Buffer;            // De-allocate buffer
+         Buffer = 0;                             // Reset everything
+         Mask = 0;  MaxNum = 0;
+         head.store(0);  tail.store(0);
+      }
+      // Request to reduce size. Ignore
+      return;
+   }
+   int NewSize = 2;
+   while (NewSize < num) {
+      NewSize *= 2;
+      if (NewSize <= 0) {Error(1, num); return;} // Overflow
+   }
+   Cell * Buffer2 = new Cell[NewSize];           // Allocate new buffer
+   if (Buffer2 == 0) {Error(3, NewSize); return;}// Error can't allocate
+   // Copy queue from old to new buffer. Positions start at 0 in the new buffer
+   size_t t = tail.load(), n = head.load() - t;
+   size_t i;
+   for (i = 0; i < n; i++) {
+      Buffer2[i].Data = Buffer[(t + i) & Mask].Data;
+      Buffer2[i].Sequence.store(i + 1);         // Full
+   }
+   for (; i < (size_t)NewSize; i++) {
+      Buffer2[i].Sequence.store(i);             // Free
+   }
+   if (Buffer) delete[] Buffer;                  // De-allocate old buffer
+   Buffer = Buffer2;                             // Save pointer to buffer
+   MaxNum = NewSize;                             // Save new size
+   Mask = NewSize - 1;
+   tail.store(0);  head.store(n);
+}
+
+
+template <typename TX>
+int ConcurrentQueue<TX>::GetNum() {
+   // Get number of objects stored
+   size_t t = tail.load(std::memory_order_acquire);
+   size_t h = head.load(std::memory_order_acquire);
+   return h > t ? int(h - t) : 0;                // Threads may be between claiming and releasing a position
+}
+
+
+template <typename TX>
+bool ConcurrentQueue<TX>::TryPut(TX const & obj) {
+   // Add object to head of queue. Returns false if full
+   if (Buffer == 0) {Error(2, 0); return false;}
+   Cell * c;
+   size_t pos = head.load(std::memory_order_relaxed);
+   for (;;) {
+      c = Buffer + (pos & Mask);
+      size_t seq = c->Sequence.load(std::memory_order_acquire);
+      intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+      if (dif == 0) {
+         // Position is free. Claim it
+         if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+         // Another thread was first. pos has been updated
+      }
+      else if (dif < 0) {
+         return false;                           // Queue is full
+      }
+      else {
+         pos = head.load(std::memory_order_relaxed); // Another thread has put here. Try again
+      }
+   }
+   c->Data = obj;                                // Store object
+   c->Sequence.store(pos + 1, std::memory_order_release); // Mark position as full
+   // Wake a sleeping getter. The fence makes sure that a getter that is
+   // going to sleep either sees the new object or is seen here
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (GettersWaiting.load(std::memory_order_relaxed) > 0) {
+      PutEvents.fetch_add(1, std::memory_order_release);
+      Wake(PutEvents);
+   }
+   return true;
+}
+
+
+template <typename TX>
+bool ConcurrentQueue<TX>::TryGet(TX & obj) {
+   // Take object out from tail of queue. Returns false if empty
+   if (Buffer == 0) {Error(2, 0); return false;}
+   Cell * c;
+   size_t pos = tail.load(std::memory_order_relaxed);
+   for (;;) {
+      c = Buffer + (pos & Mask);
+      size_t seq = c->Sequence.load(std::memory_order_acquire);
+      intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (dif == 0) {
+         // Position is full. Claim it
+         if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      }
+      else if (dif < 0) {
+         return false;                           // Queue is empty
+      }
+      else {
+         pos = tail.load(std::memory_order_relaxed); // Another thread has got this. Try again
+      }
+   }
+   obj = c->Data;                                // Read object
+   c->Sequence.store(pos + Mask + 1, std::memory_order_release); // Free position for next round
+   // Wake a sleeping putter
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (PuttersWaiting.load(std::memory_order_relaxed) > 0) {
+      GetEvents.fetch_add(1, std::memory_order_release);
+      Wake(GetEvents);
+   }
+   return true;
+}
+
+
+template <typename TX>
+void ConcurrentQueue<TX>::Put(TX const & obj) {
+   // Add object to head of queue. Waits while full
+   for (int i = 0; ; i++) {
+      if (TryPut(obj)) return;
+      if (i < SpinCount) {
+         std::this_thread::yield();              // Give a getter a chance
+         continue;
+      }
+      // Go to sleep. The event counter is read before registering as waiting,
+      // so that a get after this point makes Wait return
+      int e = GetEvents.load(std::memory_order_acquire);
+      PuttersWaiting.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      bool success = TryPut(obj);
+      if (!success) Wait(GetEvents, e);
+      PuttersWaiting.fetch_sub(1);
+      if (success) return;
+   }
+}
+
+
+template <typename TX>
+TX ConcurrentQueue<TX>::Get() {
+   // Take object out from tail of queue. Waits while empty
+   TX obj;
+   for (int i = 0; ; i++) {
+      if (TryGet(obj)) return obj;
+      if (i < SpinCount) {
+         std::this_thread::yield();              // Give a putter a chance
+         continue;
+      }
+      // Go to sleep
+      int e = PutEvents.load(std::memory_order_acquire);
+      GettersWaiting.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      bool success = TryGet(obj);
+      if (!success) Wait(PutEvents, e);
+      GettersWaiting.fetch_sub(1);
+      if (success) return obj;
+   }
+}
+
+
+#if defined(__linux__)
+// Sleep with futex on Linux. std::atomic<int> has the same layout as int
+template <typename TX>
+void ConcurrentQueue<TX>::Wait(std::atomic<int> & event, int value) {
+   static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex needs plain int");
+   // Returns immediately if event != value
+   syscall(SYS_futex, reinterpret_cast<int*>(&event), FUTEX_WAIT_PRIVATE, value, 0, 0, 0);
+}
+
+template <typename TX>
+void ConcurrentQueue<TX>::Wake(std::atomic<int> & event) {
+   syscall(SYS_futex, reinterpret_cast<int*>(&event), FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+}
+#else
+// Other systems. Yield time slice and try again
+template <typename TX>
+void ConcurrentQueue<TX>::Wait(std::atomic<int> & event, int value) {
+   if (event.load(std::memory_order_acquire) == value) std::this_thread::yield();
+}
+
+template <typename TX>
+void ConcurrentQueue<TX>::Wake(std::atomic<int> & event) {
+}
+#endif
+
+
+// Produce fatal error message. Used internally.
+// Note: If your program has a graphical user interface (GUI) then you
+// must rewrite this function to produce a message box with the error message.
+template <typename TX>
+void ConcurrentQueue<TX>::Error(int e, int n) {
+   // Define error texts
+   static const char * ErrorTexts[] = {
+      "Unknown error",                 // 0
+      "Size out of range",             // 1
+      "No buffer. Call Reserve first", // 2
+      "Memory allocation failed"       // 3
+   };
+   // Number of texts in ErrorTexts
+   const unsigned int NumErrorTexts = sizeof(ErrorTexts) / sizeof(*ErrorTexts);
+
+   // check that index is within range
+   if ((unsigned int)e >= NumErrorTexts) e = 0;
+
+   // Replace this with your own error routine, possibly with a message box:
+   fprintf(stderr, "\nConcurrentQueue error: %s (%i)\n", ErrorTexts[e], n);
+
+   // Terminate execution
+   exit(1);
+}
+
+
+/******************************************************************************
+Example part. Remove this from final application:
+******************************************************************************/
+
+// The benchmark compares with DynamicQueue from DynamicQueue.cpp protected
+// by a mutex. Its example main function is renamed so that this file has
+// only one main:
+#define main DynamicQueueExample
+#include "DynamicQueue.cpp"
+#undef main
+
+#include <mutex>                                 // Needed for example only
+#include <chrono>                                // Needed for example only
+#include <vector>                                // Needed for example only
+
+// DynamicQueue protected by a mutex, with Put and Get as in ConcurrentQueue
+template <typename TX>
+class MutexQueue {
+public:
+   void Reserve(int num) {queue.Reserve(num);}
+   void Put(TX const & obj) {
+      std::lock_guard<std::mutex> guard(lock);
+      queue.Put(obj);
+   }
+   TX Get() {
+      for (;;) {
+         {
+            std::lock_guard<std::mutex> guard(lock);
+            if (queue.GetNum() > 0) return queue.Get();
+         }
+         std::this_thread::yield();              // Empty. Wait for a putter
+      }
+   }
+private:
+   std::mutex lock;
+   DynamicQueue<TX> queue;
+};
+
+// Time the transfer of NumMessages integers with nthreads producers and
+// nthreads consumers. Returns messages per second. Checks the sum
+template <typename QUEUE>
+double Throughput(QUEUE & queue, int nthreads) {
+   const int NumMessages = 1 << 21;
+   const int PerThread = NumMessages / nthreads;
+   std::atomic<long long> sum(0);
+   std::vector<std::thread> threads;
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   for (int t = 0; t < nthreads; t++) {
+      threads.push_back(std::thread([&queue, t, PerThread]() {
+         for (int i = 0; i < PerThread; i++) queue.Put(t * PerThread + i);
+      }));
+      threads.push_back(std::thread([&queue, &sum, PerThread]() {
+         long long s = 0;
+         for (int i = 0; i < PerThread; i++) s += queue.Get();
+         sum += s;
+      }));
+   }
+   for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+   double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   long long n = (long long)PerThread * nthreads;
+   if (sum != n * (n - 1) / 2) printf("  Error: wrong sum");
+   return n / time;
+}
+
+int main() {
+   // Make instance of ConcurrentQueue containing objects of type int:
+   ConcurrentQueue<int> queue;
+
+   // Reserve space before the queue is shared between threads
+   queue.Reserve(100);
+
+   // Put data into the queue from another thread
+   std::thread producer([&queue]() {
+      queue.Put(10);
+      queue.Put(20);
+      queue.Put(30);
+   });
+
+   // Remove entries, First-In-First-Out. Get waits for the producer
+   for (int i = 0; i < 3; i++) {
+      printf("\n     %5i", queue.Get());
+   }
+   producer.join();
+
+   // Print blank line
+   printf("\n");
+
+   // Scaling benchmark
+   printf("\nMessages per second with n producers and n consumers:");
+   printf("\n    n   ConcurrentQueue   DynamicQueue + mutex");
+   for (int n = 1; n <= 32; n *= 2) {
+      ConcurrentQueue<int> cq;  cq.Reserve(4096);
+      MutexQueue<int> mq;       mq.Reserve(4096);
+      printf("\n%5i %17.0f", n, Throughput(cq, n));
+      printf(" %22.0f", Throughput(mq, n));
+   }
+   printf("\n");
+
+   return 0;
+}
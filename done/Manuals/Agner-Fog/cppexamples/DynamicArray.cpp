@@ -1,13 +1,13 @@
 /*************************  DynamicArray.cpp  *********************************
 * Author:        Agner Fog
 * Date created:  2008-06-12
-* Last modified: 2008-07-24
+* Last modified: 2026-10-19
 * Description:
 * Defines linear array of dynamic size.
 *
 * The latest version of this file is available at:
 * www.agner.org/optimize/cppexamples.zip
-* (c) 2008 GNU General Public License www.gnu.org/copyleft/gpl.html
+* (c) 2008-2026 GNU General Public License www.gnu.org/copyleft/gpl.html
 *******************************************************************************
 *
 * DynamicArray is a container class defining a dynamic array or memory pool 
@@ -25,6 +25,13 @@
 * private instance of DynamicArray, or you must prevent other threads from
 * accessing DynamicArray while you are adding objects.
 *
+* Big buffers of MAPTHRESHOLD bytes or more are allocated with mmap on Linux.
+* Such a buffer is made bigger with mremap, which moves the memory pages to a
+* new virtual address without copying any data. Push is therefore fast even
+* when it has to re-allocate a big buffer, and the peak memory use is not
+* tripled during the re-allocation. Set HUGEPAGES to 1 to ask for transparent
+* huge pages for these buffers. Set MAPTHRESHOLD to 0 to always use new.
+*
 * Note that you should never store a pointer to an object in DynamicArray
 * if Push() is used because the pointer will become invalid in case a 
 * subsequent addition of another object by Push() causes the memory to be 
@@ -57,6 +64,19 @@ Header part. Put this in a .h file:
 #include <memory.h>                              // For memcpy and memset
 #include <stdlib.h>                              // For exit in Error function
 #include <stdio.h>                               // Needed for example only
+#include <time.h>                                // Needed for example only
+#if defined(__linux__)
+#include <sys/mman.h>                            // For mmap and mremap
+#include <unistd.h>                              // For sysconf
+#include <sys/resource.h>                        // Needed for example only
+#endif
+
+#ifndef MAPTHRESHOLD
+#define MAPTHRESHOLD  (1 << 21)                  // Buffers of this size or bigger are allocated with mmap on Linux. 0 = never
+#endif
+#ifndef HUGEPAGES
+#define HUGEPAGES     0                          // 1 will use transparent huge pages for buffers allocated with mmap
+#endif
 
 
 // Class DynamicArray makes a dynamic array which can grow as new data are added
@@ -80,7 +100,9 @@ private:
    TX * Buffer;                                  // Buffer containing data
    TX * OldBuffer;                               // Old buffer before re-allocation
    int MaxNum;                                   // Maximum number of objects that buffer can contain
+   size_t MappedSize;                            // Size of buffer if allocated with mmap, 0 if allocated with new
    void ReAllocate(int num);                     // Allocate new memory buffer, leave OldBuffer intact
+   void ReAllocateMapped(int num);               // Allocate or grow buffer with mmap or mremap
    DynamicArray(DynamicArray const&){};          // Make private copy constructor to prevent copying
    void operator = (DynamicArray const&){};      // Make private assignment operator to prevent copying
 protected:
@@ -95,6 +117,7 @@ DynamicArray<TX>::DynamicArray() {
    // Constructor
    Buffer = OldBuffer = 0;
    MaxNum = NumEntries = 0;
+   MappedSize = 0;
 }
 
 
@@ -117,9 +140,14 @@ void DynamicArray<TX>::Reserve(int num) {
       if (num <= 0) {
          if (num < 0) Error(1, num);
          // num = 0. Discard data and de-allocate buffer
+#if defined(__linux__)
+         if (MappedSize) munmap(Buffer, MappedSize); // De-allocate buffer allocated with mmap
+         else
+#endif
          if (Buffer) delete[] Buffer;            // De-allocate buffer
          Buffer = 0;
          MaxNum = NumEntries = 0;
+         MappedSize = 0;
          return;
       }
       // Request to reduce size. Ignore
@@ -142,6 +170,13 @@ void DynamicArray<TX>::ReAllocate(int num) {
    // happens to be contained in the old buffer.
    if (OldBuffer) delete[] OldBuffer;            // Should not occur in single-threaded applications
 
+#if defined(__linux__)
+   if (MAPTHRESHOLD > 0 && (size_t)num * sizeof(TX) >= (size_t)MAPTHRESHOLD) {
+      // Big buffer. Use mmap
+      ReAllocateMapped(num);
+      return;
+   }
+#endif
    TX * Buffer2 = 0;                             // New buffer
    Buffer2 = new TX[num];                        // Allocate new buffer
    if (Buffer2 == 0) {Error(3,num); return;}     // Error can't allocate
@@ -155,6 +190,39 @@ void DynamicArray<TX>::ReAllocate(int num) {
 }
 
 
+#if defined(__linux__)
+template <typename TX>
+void DynamicArray<TX>::ReAllocateMapped(int num) {
+   // Allocate buffer with mmap, or make it bigger with mremap.
+   // mremap moves the memory pages by changing the page table, without
+   // copying the data. The old buffer is gone after mremap, so there
+   // is no OldBuffer in this case.
+   size_t PageSize = (size_t)sysconf(_SC_PAGESIZE);
+   size_t NewSize = ((size_t)num * sizeof(TX) + PageSize - 1) & ~(PageSize - 1);
+   void * Buffer2;                               // New buffer
+   if (MappedSize) {
+      // Buffer is already allocated with mmap. Grow it
+      Buffer2 = mremap(Buffer, MappedSize, NewSize, MREMAP_MAYMOVE);
+   }
+   else {
+      // Buffer is allocated with new or not at all. Allocate new buffer and copy data
+      Buffer2 = mmap(0, NewSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (Buffer2 != MAP_FAILED && Buffer) {
+         memcpy(Buffer2, Buffer, MaxNum*sizeof(TX)); // Copy contents of old buffer into new one
+         OldBuffer = Buffer;                     // Must be deleted by calling function
+      }
+   }
+   if (Buffer2 == MAP_FAILED) {Error(3,num); return;} // Error can't allocate
+#if HUGEPAGES
+   madvise(Buffer2, NewSize, MADV_HUGEPAGE);     // Ask for transparent huge pages
+#endif
+   Buffer = (TX*)Buffer2;                        // Save pointer to buffer
+   MappedSize = NewSize;
+   MaxNum = num;                                 // Save new size
+}
+#endif
+
+
 template <typename TX>
 void DynamicArray<TX>::SetNum(int num) {
    // Set the number of objects that are considered used and valid.
@@ -189,6 +257,13 @@ int DynamicArray<TX>::Push(const TX & obj) {
       // buffer too small or no buffer. Allocate more memory
       // Determine new size = 2 * current size + the number of objects that correspond to AllocateSpace
       int NewSize = MaxNum * 2 + (AllocateSpace+sizeof(TX)-1)/sizeof(TX);
+      if (MappedSize) {
+         // obj might be contained in the buffer, which is moved by mremap
+         TX temp = obj;
+         ReAllocate(NewSize);
+         Buffer[NumEntries] = temp;
+         return NumEntries++;
+      }
       ReAllocate(NewSize);
    }
    Buffer[NumEntries] = obj;                     // Insert at top
@@ -315,5 +390,25 @@ int main() {
    // Print blank line
    printf("\n");
 
+   // 3. Growing a big array.
+   // 4M objects (16 MB) is enough to make the buffer grow with mremap.
+   // Compile with -DEXAMPLESIZE=67108864 for a bigger array (256 MB), and
+   // with -DMAPTHRESHOLD=0 to compare with re-allocation by new
+#ifndef EXAMPLESIZE
+#define EXAMPLESIZE  (4 << 20)
+#endif
+   clock_t start = clock();
+   for (i = 0; i < EXAMPLESIZE; i++) {
+      list.Push(i);
+   }
+   double time = double(clock() - start) / CLOCKS_PER_SEC;
+   printf("\nPushed %i objects in %.3f s", list.GetNum(), time);
+#if defined(__linux__)
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   printf("\nPeak memory use %.0f MB", usage.ru_maxrss / 1024.);
+#endif
+   printf("\n");
+
    return 0;
 }
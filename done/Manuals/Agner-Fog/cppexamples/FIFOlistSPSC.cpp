@@ -0,0 +1,300 @@
+/*************************  FIFOlistSPSC.cpp   *******************************
+* Author:        cppexamples contributors. Based on FIFOlist by Agner Fog
+* Date created:  2026-10-19
+* Last modified: 2026-10-19
+* Description:
+* Template class for lock-free single-producer single-consumer FIFO list
+*
+* (c) 2026 GNU General Public License www.gnu.org/copyleft/gpl.html
+*******************************************************************************
+*
+* FIFOlistSPSC is a circular array with First-In-First-Out access like
+* FIFOlist in FIFOlist.cpp, but it can be used by two threads at the same
+* time without a mutex: one thread calling Put and PutN (the producer) and
+* one thread calling Get and GetN (the consumer). It does not work with more
+* than one producer or more than one consumer.
+*
+* The head index is written only by the producer and the tail index only by
+* the consumer. Each is on its own cache line, so that the two threads do not
+* compete for the same cache line (false sharing). The producer keeps a
+* private copy of the tail and reads the consumer's cache line only when the
+* copy says that the list is full. The consumer does the same with the head.
+* The objects are published with release stores and read after acquire loads,
+* so no other memory barriers are needed.
+*
+* PutN and GetN transfer many objects with one update of the shared index.
+* This is much faster than single Put and Get when the objects are small.
+*
+* Get returns false when the list is empty, and Put returns false when it is
+* full. The caller decides whether to spin, yield or do other work.
+*
+* The size is defined at compile time. The elements in the array can be of
+* any type that do not require a constructor or destructor. This requires
+* C++11 (for <atomic>). Objects of this class must be static or allocated
+* with an alignment of 64, e.g. with operator new in C++17.
+*
+* An example of how to use FIFOlistSPSC is provided at the end of this file,
+* including a benchmark against FIFOlist protected by a mutex.
+*
+******************************************************************************/
+
+/******************************************************************************
+Header part. Put this in a .h file:
+******************************************************************************/
+
+#include <atomic>                      // For std::atomic
+#include <memory.h>                    // For memcpy
+#include <stdio.h>                     // Needed for example only
+#include <thread>                      // Needed for example only
+#include <mutex>                       // Needed for example only
+#include <chrono>                      // Needed for example only
+
+
+// Template for lock-free single-producer single-consumer FIFO list
+template <typename OBJTYPE, int MAXSIZE>
+class FIFOlistSPSC {
+protected:
+   // The head and tail indexes run from 0 to 2*MAXSIZE-1 so that a full
+   // list can be distinguished from an empty list without a counter
+   // shared by the two threads
+   static int Advance(int i, int k) {  // Add k to index
+      i += k;
+      if (i >= 2 * MAXSIZE) i -= 2 * MAXSIZE;
+      return i;
+   }
+   static int Count(int h, int t) {    // Number of objects from t to h
+      int c = h - t;
+      if (c < 0) c += 2 * MAXSIZE;
+      return c;
+   }
+   static int Slot(int i) {            // Position in list of index i
+      return i < MAXSIZE ? i : i - MAXSIZE;
+   }
+   // Copy n objects to or from the circular buffer at index i
+   void CopyIn(int i, OBJTYPE const * x, int n) {
+      int s = Slot(i);
+      int n1 = MAXSIZE - s;            // Number of objects before wrap around
+      if (n1 > n) n1 = n;
+      memcpy(list + s, x, n1 * sizeof(OBJTYPE));
+      memcpy(list, x + n1, (n - n1) * sizeof(OBJTYPE));
+   }
+   void CopyOut(int i, OBJTYPE * x, int n) {
+      int s = Slot(i);
+      int n1 = MAXSIZE - s;
+      if (n1 > n) n1 = n;
+      memcpy(x, list + s, n1 * sizeof(OBJTYPE));
+      memcpy(x + n1, list, (n - n1) * sizeof(OBJTYPE));
+   }
+
+   // Producer cache line
+   alignas(64) std::atomic<int> head;  // Index of next object to put. Written by producer
+   int tailCache;                      // Producer's copy of tail
+   // Consumer cache line
+   alignas(64) std::atomic<int> tail;  // Index of next object to get. Written by consumer
+   int headCache;                      // Consumer's copy of head
+   // Circular buffer
+   alignas(64) OBJTYPE list[MAXSIZE];
+public:
+   FIFOlistSPSC() {                    // Constructor
+      head.store(0, std::memory_order_relaxed);   // Initialize
+      tail.store(0, std::memory_order_relaxed);
+      tailCache = headCache = 0;
+   }
+   bool Put(OBJTYPE const & x) {       // Put object into list. Producer only
+      int h = head.load(std::memory_order_relaxed);
+      if (Count(h, tailCache) >= MAXSIZE) {
+         tailCache = tail.load(std::memory_order_acquire);
+         if (Count(h, tailCache) >= MAXSIZE) {
+            return false;              // Return false if list full
+         }
+      }
+      list[Slot(h)] = x;               // Copy x to list
+      head.store(Advance(h, 1), std::memory_order_release);  // Publish
+      return true;                     // Return true if success
+   }
+   bool Get(OBJTYPE & x) {             // Get object from list. Consumer only
+      int t = tail.load(std::memory_order_relaxed);
+      if (t == headCache) {
+         headCache = head.load(std::memory_order_acquire);
+         if (t == headCache) {
+            return false;              // Return false if list empty
+         }
+      }
+      x = list[Slot(t)];               // Copy object to x
+      tail.store(Advance(t, 1), std::memory_order_release);  // Release slot
+      return true;                     // Return true if success
+   }
+   // Put up to n objects from array x. Returns the number of objects put.
+   // Producer only
+   int PutN(OBJTYPE const * x, int n) {
+      int h = head.load(std::memory_order_relaxed);
+      int room = MAXSIZE - Count(h, tailCache);
+      if (room < n) {
+         tailCache = tail.load(std::memory_order_acquire);
+         room = MAXSIZE - Count(h, tailCache);
+      }
+      if (n > room) n = room;
+      if (n <= 0) return 0;
+      CopyIn(h, x, n);
+      head.store(Advance(h, n), std::memory_order_release);
+      return n;
+   }
+   // Get up to n objects into array x. Returns the number of objects got.
+   // Consumer only
+   int GetN(OBJTYPE * x, int n) {
+      int t = tail.load(std::memory_order_relaxed);
+      int avail = Count(headCache, t);
+      if (avail < n) {
+         headCache = head.load(std::memory_order_acquire);
+         avail = Count(headCache, t);
+      }
+      if (n > avail) n = avail;
+      if (n <= 0) return 0;
+      CopyOut(t, x, n);
+      tail.store(Advance(t, n), std::memory_order_release);
+      return n;
+   }
+   int NumObjects() {                  // Tell number of objects in list
+      // The result may be out of date when the other thread is active
+      return Count(head.load(std::memory_order_acquire), tail.load(std::memory_order_acquire));
+   }
+};
+
+
+/******************************************************************************
+Example part. Remove this from final application:
+******************************************************************************/
+
+// The benchmark compares with FIFOlist from FIFOlist.cpp protected by a mutex.
+// Its example main function is renamed so that this file has only one main:
+#define main FIFOlistExample
+#include "FIFOlist.cpp"
+#undef main
+
+// FIFOlist protected by a mutex, with the same interface as FIFOlistSPSC
+template <typename OBJTYPE, int MAXSIZE>
+class FIFOlistMutex {
+protected:
+   std::mutex lock;
+   FIFOlist<OBJTYPE, MAXSIZE> list;
+public:
+   bool Put(OBJTYPE const & x) {
+      std::lock_guard<std::mutex> guard(lock);
+      return list.Put(x);
+   }
+   bool Get(OBJTYPE & x) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (list.NumObjects() <= 0) return false;
+      x = list.Get();
+      return true;
+   }
+   int PutN(OBJTYPE const * x, int n) {
+      std::lock_guard<std::mutex> guard(lock);
+      int i;
+      for (i = 0; i < n && list.Put(x[i]); i++) {}
+      return i;
+   }
+   int GetN(OBJTYPE * x, int n) {
+      std::lock_guard<std::mutex> guard(lock);
+      int i;
+      for (i = 0; i < n && list.NumObjects() > 0; i++) x[i] = list.Get();
+      return i;
+   }
+};
+
+typedef std::chrono::steady_clock Clock;
+
+double Seconds(Clock::time_point start) {
+   return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+const int QueueSize = 1024;
+const int NumMessages = 4000000;
+const int Batch = 32;                  // Objects per PutN and GetN
+
+// Throughput: one thread puts NumMessages integers, the other thread gets them.
+// Returns messages per second. Checks the sum of the messages
+template <typename QUEUE>
+double Throughput(QUEUE & q, bool bulk) {
+   long long sum = 0;
+   Clock::time_point start = Clock::now();
+   std::thread consumer([&]() {
+      int buf[Batch];
+      int received = 0;
+      while (received < NumMessages) {
+         int n = bulk ? q.GetN(buf, Batch) : (q.Get(buf[0]) ? 1 : 0);
+         if (n == 0) std::this_thread::yield();
+         for (int i = 0; i < n; i++) sum += buf[i];
+         received += n;
+      }
+   });
+   int buf[Batch];
+   for (int i = 0; i < NumMessages; ) {
+      int n = Batch;
+      if (n > NumMessages - i) n = NumMessages - i;
+      for (int k = 0; k < n; k++) buf[k] = i + k;
+      int m = bulk ? q.PutN(buf, n) : (q.Put(buf[0]) ? 1 : 0);
+      if (m == 0) std::this_thread::yield();
+      i += m;
+   }
+   consumer.join();
+   double t = Seconds(start);
+   if (sum != (long long)NumMessages * (NumMessages - 1) / 2) {
+      printf("\nError: wrong sum");
+   }
+   return NumMessages / t;
+}
+
+// Latency: a message is sent back and forth between two threads through
+// two queues. Returns the average round trip time in microseconds
+template <typename QUEUE>
+double RoundTrip(QUEUE & ping, QUEUE & pong) {
+   const int Trips = 100000;
+   std::thread echo([&]() {
+      int x;
+      for (int i = 0; i < Trips; i++) {
+         while (!ping.Get(x)) std::this_thread::yield();
+         while (!pong.Put(x)) std::this_thread::yield();
+      }
+   });
+   Clock::time_point start = Clock::now();
+   int x;
+   for (int i = 0; i < Trips; i++) {
+      while (!ping.Put(i)) std::this_thread::yield();
+      while (!pong.Get(x)) std::this_thread::yield();
+   }
+   double t = Seconds(start);
+   echo.join();
+   return t * 1E6 / Trips;
+}
+
+// Queues are static to make sure they are aligned
+static FIFOlistSPSC<int, QueueSize> spsc1, spsc2;
+static FIFOlistMutex<int, QueueSize> mutex1, mutex2;
+
+int main() {
+
+   FIFOlistSPSC <int,1000> List;       // Make list of max 1000 int
+   std::thread producer([&]() {
+      for (int i = 10; i <= 30; i += 10) {
+         while (!List.Put(i)) {}       // Put 10, 20, 30 into the list
+      }
+   });
+   for (int k = 0; k < 3; k++) {
+      int x;
+      while (!List.Get(x)) {}         // Wait for next item
+      printf("\n%3i ", x);            // Print item
+   }                                   // Will print "10 20 30 "
+   producer.join();
+
+   // Benchmark
+   printf("\n\nMessages per second, %i messages:", NumMessages);
+   printf("\nsingle Put/Get:  SPSC %12.0f   mutex %12.0f",
+      Throughput(spsc1, false), Throughput(mutex1, false));
+   printf("\nPutN/GetN (%2i):  SPSC %12.0f   mutex %12.0f",
+      Batch, Throughput(spsc1, true), Throughput(mutex1, true));
+   printf("\nRound trip time: SPSC %10.2f us   mutex %10.2f us\n",
+      RoundTrip(spsc1, spsc2), RoundTrip(mutex1, mutex2));
+
+   return 0;
+}
@@ -0,0 +1,558 @@
+/************************  SegmentedArray.cpp  ********************************
+* Author:        cppexamples contributors. Based on DynamicArray and DynamicQueue by Agner Fog
+* Date created:  2026-10-19
+* Last modified: 2026-10-19
+* Description:
+* Defines array and queue of dynamic size stored in fixed-size segments.
+*
+* (c) 2026 GNU General Public License www.gnu.org/copyleft/gpl.html
+*******************************************************************************
+*
+* SegmentedArray and SegmentedQueue have the same interface as DynamicArray
+* and DynamicQueue, but they grow without moving the objects already stored.
+*
+* DynamicArray and DynamicQueue double the buffer and copy all objects when
+* the buffer is full. This takes a long time when the buffer is big, and
+* the old and the new buffer are both allocated during the copying, so the
+* peak memory use is three times the size of the data.
+*
+* SegmentedArray and SegmentedQueue store the objects in segments of
+* 2^SEGMENTBITS objects each. A directory contains pointers to the segments.
+* When more space is needed, one new segment is allocated and a pointer to
+* it is added to the directory. Only the directory is copied when it grows,
+* and it is small. The time for adding an object is therefore short and
+* predictable, and the memory used is never more than the data plus one
+* segment and the directory.
+*
+* Objects never move, so pointers and references to objects stay valid as
+* long as the object is stored. This is unlike DynamicArray and DynamicQueue.
+*
+* Access by index costs a shift, a mask and one extra memory read from the
+* directory, which is usually in the level-1 cache. The objects within one
+* segment are contiguous. Use GetSegment to get a pointer to each segment
+* for loops that must run at full speed, for example with SIMD instructions.
+* SegmentedQueue::GetSegment works in the same way, where segment 0 begins at
+* the tail of the queue.
+*
+* SegmentedQueue frees a segment when all objects in it have been taken out.
+* It keeps one free segment for re-use so that a queue that stays at the
+* same size does not allocate and free memory all the time.
+*
+* The objects stored can be of any type that do not require a constructor
+* or destructor. The classes are not thread safe.
+*
+* At the end of this file you will find a working example of how to use
+* SegmentedArray and SegmentedQueue, including a benchmark of growth
+* latency against DynamicArray.
+*
+* The first part of this file containing declarations may be placed in a
+* header file. The second part containing examples should be removed from your
+* final application.
+*
+******************************************************************************/
+
+/******************************************************************************
+Header part. Put this in a .h file:
+******************************************************************************/
+
+#include <memory.h>                              // For memcpy and memset
+#include <stdlib.h>                              // For exit in Error function
+#include <stdio.h>                               // Needed for example only
+
+
+// Class SegmentedArray makes a dynamic array which can grow without moving data
+template <typename TX, int SEGMENTBITS = 12>
+class SegmentedArray {
+public:
+   SegmentedArray();                             // Constructor
+   ~SegmentedArray();                            // Destructor
+   void Reserve(int num);                        // Allocate segments for num objects
+   void SetNum(int num);                         // Set the number of valid entries. New entries will be zero
+   int GetNum(){return NumEntries;};             // Get number of objects stored
+   int GetMaxNum(){return NumSegments << SEGMENTBITS;}; // Get number of objects that can be stored without allocating memory
+   int Push(TX const & obj);                     // Add object to end of array. Return its index
+   TX Pop();                                     // Take last object out of list
+   TX & operator[] (int i);                      // Access object with index i
+   TX * GetSegment(int s, int & n);              // Get segment s and the number n of valid objects in it
+   int GetNumSegments() {                        // Get number of segments that contain objects
+      return (NumEntries + SegmentSize - 1) >> SEGMENTBITS;}
+   // Define segment size
+   enum DefineSize {
+      SegmentSize = 1 << SEGMENTBITS,            // Number of objects in each segment
+      SegmentMask = SegmentSize - 1,
+      DirectorySpace = 64                        // Minimum size of directory
+   };
+private:
+   TX ** Directory;                              // Pointers to segments
+   int DirectorySize;                            // Number of pointers that Directory can contain
+   int NumSegments;                              // Number of segments allocated
+   void AddSegment();                            // Allocate one more segment
+   SegmentedArray(SegmentedArray const&){};      // Make private copy constructor to prevent copying
+   void operator = (SegmentedArray const&){};    // Make private assignment operator to prevent copying
+protected:
+   int NumEntries;                               // Number of objects stored
+   void Error(int e, int n);                     // Make fatal error message
+};
+
+
+// Members of class SegmentedArray
+template <typename TX, int SEGMENTBITS>
+SegmentedArray<TX, SEGMENTBITS>::SegmentedArray() {
+   // Constructor
+   Directory = 0;
+   DirectorySize = NumSegments = NumEntries = 0;
+}
+
+
+template <typename TX, int SEGMENTBITS>
+SegmentedArray<TX, SEGMENTBITS>::~SegmentedArray() {
+   // Destructor
+   Reserve(0);                                   // De-allocate all segments
+}
+
+
+template <typename TX, int SEGMENTBITS>
+void SegmentedArray<TX, SEGMENTBITS>::Reserve(int num) {
+   // Allocate segments for the specified number of objects.
+   // Setting num > current GetMaxNum() will allocate more segments.
+   // Existing data are not moved.
+   // Setting num <= current GetMaxNum() will do nothing.
+   // Setting num = 0 will discard all data and de-allocate all segments.
+   if (num <= 0) {
+      if (num < 0) Error(1, num);
+      // num = 0. Discard data and de-allocate segments
+      for (int s = 0; s < NumSegments; s++) delete[] Directory[s];
+      if (Directory) delete[] Directory;
+      Directory = 0;
+      DirectorySize = NumSegments = NumEntries = 0;
+      return;
+   }
+   while (GetMaxNum() < num) AddSegment();
+}
+
+
+template <typename TX, int SEGMENTBITS>
+void SegmentedArray<TX, SEGMENTBITS>::AddSegment() {
+   // Allocate one more segment. Used only internally
+   if (NumSegments >= DirectorySize) {
+      // Directory is full. Make it bigger. Only the pointers are copied
+      int NewSize = DirectorySize * 2 + DirectorySpace;
+      TX ** Directory2 = new TX*[NewSize];
+      if (Directory2 == 0) {Error(3, NewSize); return;}
+      if (Directory) {
+         memcpy(Directory2, Directory, NumSegments * sizeof(TX*));
+         delete[] Directory;
+      }
+      Directory = Directory2;
+      DirectorySize = NewSize;
+   }
+   TX * Segment = new TX[SegmentSize];           // Allocate new segment
+   if (Segment == 0) {Error(3, SegmentSize); return;}
+   Directory[NumSegments++] = Segment;
+}
+
+
+template <typename TX, int SEGMENTBITS>
+void SegmentedArray<TX, SEGMENTBITS>::SetNum(int num) {
+   // Set the number of objects that are considered used and valid.
+   // Setting num > NumEntries is equivalent to pushing (num - NumEntries)
+   // objects with zero contents.
+   // Setting num < NumEntries will decrease NumEntries so that all objects
+   // with index >= num are erased.
+   // Setting num = 0 will erase all objects, but not de-allocate segments.
+   if (num < 0) { // Cannot be negative
+      Error(1, num); return;
+   }
+   Reserve(num);
+   // Fill new entries with zero, segment by segment
+   for (int i = NumEntries; i < num; ) {
+      int n = SegmentSize - (i & SegmentMask);   // Space in this segment
+      if (n > num - i) n = num - i;
+      memset(Directory[i >> SEGMENTBITS] + (i & SegmentMask), 0, n * sizeof(TX));
+      i += n;
+   }
+   NumEntries = num;
+}
+
+
+template <typename TX, int SEGMENTBITS>
+int SegmentedArray<TX, SEGMENTBITS>::Push(TX const & obj) {
+   // Add object to end of array, return index
+   if (NumEntries >= GetMaxNum()) {
+      // All segments full. Allocate one more.
+      // obj stays valid even if it is contained in this array
+      AddSegment();
+   }
+   Directory[NumEntries >> SEGMENTBITS][NumEntries & SegmentMask] = obj;
+   return NumEntries++;                          // Increment NumEntries and return current index
+}
+
+
+template <typename TX, int SEGMENTBITS>
+TX SegmentedArray<TX, SEGMENTBITS>::Pop() {
+   // Remove last object and return it
+   if (NumEntries <= 0) {
+      // Array is empty. Make error message
+      Error(2, 0);
+      // Return empty object
+      TX temp;
+      memset(&temp, 0, sizeof(temp));
+      return temp;
+   }
+   // Return object and decrement NumEntries
+   NumEntries--;
+   return Directory[NumEntries >> SEGMENTBITS][NumEntries & SegmentMask];
+}
+
+
+template <typename TX, int SEGMENTBITS>
+TX & SegmentedArray<TX, SEGMENTBITS>::operator[] (int i) {
+   // Access object with index i
+   if ((unsigned int)i >= (unsigned int)NumEntries) {
+      // Index i does not exist
+      Error(1, i);  i = 0;
+   }
+   return Directory[i >> SEGMENTBITS][i & SegmentMask];
+}
+
+
+template <typename TX, int SEGMENTBITS>
+TX * SegmentedArray<TX, SEGMENTBITS>::GetSegment(int s, int & n) {
+   // Get pointer to segment s. n receives the number of valid objects in it.
+   // Segment s contains the objects with index s*SegmentSize to s*SegmentSize+n-1
+   if ((unsigned int)s >= (unsigned int)GetNumSegments()) {
+      Error(1, s);  n = 0;
+      return 0;
+   }
+   n = NumEntries - (s << SEGMENTBITS);
+   if (n > SegmentSize) n = SegmentSize;
+   return Directory[s];
+}
+
+
+// Produce fatal error message. Used internally.
+// Note: If your program has a graphical user interface (GUI) then you
+// must rewrite this function to produce a message box with the error message.
+template <typename TX, int SEGMENTBITS>
+void SegmentedArray<TX, SEGMENTBITS>::Error(int e, int n) {
+   // Define error texts
+   static const char * ErrorTexts[] = {
+      "Unknown error",                 // 0
+      "Index out of range",            // 1
+      "Array is empty",                // 2
+      "Memory allocation failed"       // 3
+   };
+   // Number of texts in ErrorTexts
+   const unsigned int NumErrorTexts = sizeof(ErrorTexts) / sizeof(*ErrorTexts);
+
+   // check that index is within range
+   if ((unsigned int)e >= NumErrorTexts) e = 0;
+
+   // Replace this with your own error routine, possibly with a message box:
+   fprintf(stderr, "\nSegmentedArray error: %s (%i)\n", ErrorTexts[e], n);
+
+   // Terminate execution
+   exit(1);
+}
+
+
+// Class SegmentedQueue makes a First-In-First-Out queue which can grow without moving data
+template <typename TX, int SEGMENTBITS = 12>
+class SegmentedQueue {
+public:
+   SegmentedQueue();                             // Constructor
+   ~SegmentedQueue();                            // Destructor
+   void Reserve(int num);                        // Allocate segments for num objects
+   int GetNum(){return NumEntries;};             // Get number of objects stored
+   int GetMaxNum(){                              // Get number of objects that can be stored without allocating memory
+      return (NumSegments << SEGMENTBITS) - Tail + (Spare ? SegmentSize : 0);};
+   void Put(TX const & obj);                     // Add object to head of queue
+   TX Get();                                     // Take object out from tail of queue
+   TX & operator[] (int i);                      // Access object with index i from the tail
+   TX * GetSegment(int s, int & n);              // Get segment s from the tail and the number n of valid objects in it
+   int GetNumSegments() {                        // Get number of segments that contain objects
+      return (Tail + NumEntries + SegmentSize - 1) >> SEGMENTBITS;}
+   // Define segment size
+   enum DefineSize {
+      SegmentSize = 1 << SEGMENTBITS,            // Number of objects in each segment
+      SegmentMask = SegmentSize - 1,
+      DirectorySpace = 64                        // Minimum size of directory
+   };
+private:
+   TX ** Directory;                              // Circular buffer of pointers to segments, first segment at DirectoryStart
+   TX * Spare;                                   // Empty segment kept for re-use
+   int DirectorySize;                            // Number of pointers that Directory can contain
+   int DirectoryStart;                           // Position in Directory of segment containing tail
+   int NumSegments;                              // Number of segments in Directory
+   int Tail;                                     // Position of tail in first segment
+   int NumEntries;                               // Number of objects stored
+   TX * Segment(int s) {                         // Get segment number s from tail
+      s += DirectoryStart;
+      if (s >= DirectorySize) s -= DirectorySize; // Wrap around
+      return Directory[s];
+   }
+   void AddSegment();                            // Add one segment at head
+   void Error(int e, int n);                     // Make fatal error message
+   SegmentedQueue(SegmentedQueue const&){};      // Make private copy constructor to prevent copying
+   void operator = (SegmentedQueue const&){};    // Make private assignment operator to prevent copying
+};
+
+
+// Members of class SegmentedQueue
+template <typename TX, int SEGMENTBITS>
+SegmentedQueue<TX, SEGMENTBITS>::SegmentedQueue() {
+   // Constructor
+   Directory = 0;  Spare = 0;
+   DirectorySize = DirectoryStart = NumSegments = Tail = NumEntries = 0;
+}
+
+
+template <typename TX, int SEGMENTBITS>
+SegmentedQueue<TX, SEGMENTBITS>::~SegmentedQueue() {
+   // Destructor
+   Reserve(0);                                   // De-allocate all segments
+}
+
+
+template <typename TX, int SEGMENTBITS>
+void SegmentedQueue<TX, SEGMENTBITS>::Reserve(int num) {
+   // Allocate segments for the specified number of objects.
+   // Setting num > current GetMaxNum() will allocate more segments.
+   // Existing data are not moved.
+   // Setting num <= current GetMaxNum() will do nothing.
+   // Setting num = 0 will discard all data and de-allocate all segments.
+   if (num <= 0) {
+      if (num < 0) Error(1, num);
+      // num = 0. Discard data and de-allocate segments
+      for (int s = 0; s < NumSegments; s++) delete[] Segment(s);
+      if (Spare) delete[] Spare;
+      if (Directory) delete[] Directory;
+      Directory = 0;  Spare = 0;
+      DirectorySize = DirectoryStart = NumSegments = Tail = NumEntries = 0;
+      return;
+   }
+   while (GetMaxNum() < num) AddSegment();
+}
+
+
+template <typename TX, int SEGMENTBITS>
+void SegmentedQueue<TX, SEGMENTBITS>::AddSegment() {
+   // Add one segment at the head end. Used only internally
+   if (NumSegments >= DirectorySize) {
+      // Directory is full. Make it bigger. Only the pointers are copied
+      int NewSize = DirectorySize * 2 + DirectorySpace;
+      TX ** Directory2 = new TX*[NewSize];
+      if (Directory2 == 0) {Error(3, NewSize); return;}
+      for (int s = 0; s < NumSegments; s++) Directory2[s] = Segment(s);
+      if (Directory) delete[] Directory;
+      Directory = Directory2;
+      DirectorySize = NewSize;
+      DirectoryStart = 0;
+   }
+   TX * NewSegment = Spare;                      // Use spare segment if there is one
+   Spare = 0;
+   if (NewSegment == 0) {
+      NewSegment = new TX[SegmentSize];          // Allocate new segment
+      if (NewSegment == 0) {Error(3, SegmentSize); return;}
+   }
+   int s = DirectoryStart + NumSegments;
+   if (s >= DirectorySize) s -= DirectorySize;   // Wrap around
+   Directory[s] = NewSegment;
+   NumSegments++;
+}
+
+
+template <typename TX, int SEGMENTBITS>
+void SegmentedQueue<TX, SEGMENTBITS>::Put(TX const & obj) {
+   // Add object to head of queue
+   int pos = Tail + NumEntries;                  // Position of head relative to first segment
+   if ((pos >> SEGMENTBITS) >= NumSegments) {
+      // All segments full. Add one more.
+      // obj stays valid even if it is contained in this queue
+      AddSegment();
+   }
+   Segment(pos >> SEGMENTBITS)[pos & SegmentMask] = obj;
+   NumEntries++;                                 // Count entries
+}
+
+
+template <typename TX, int SEGMENTBITS>
+TX SegmentedQueue<TX, SEGMENTBITS>::Get() {
+   // Remove first object and return it
+   if (NumEntries <= 0) {
+      // Queue is empty. Make error message
+      Error(2, 0);
+      // Return empty object
+      TX temp;
+      memset(&temp, 0, sizeof(temp));
+      return temp;
+   }
+   TX * First = Directory[DirectoryStart];       // Segment containing tail
+   TX obj = First[Tail];                         // Copy object before segment can be freed
+   NumEntries--;
+   if (++Tail >= SegmentSize || NumEntries == 0) {
+      // First segment is used up, or the queue is empty. Start at a new segment
+      if (Tail >= SegmentSize) {
+         // Remove first segment. Keep it as spare if there is no spare
+         if (Spare) delete[] First;
+         else Spare = First;
+         if (++DirectoryStart >= DirectorySize) DirectoryStart = 0;
+         NumSegments--;
+      }
+      Tail = 0;
+   }
+   return obj;
+}
+
+
+template <typename TX, int SEGMENTBITS>
+TX & SegmentedQueue<TX, SEGMENTBITS>::operator[] (int i) {
+   // Access object at position i from tail
+   if ((unsigned int)i >= (unsigned int)NumEntries) {
+      // Index i does not exist
+      Error(1, i);  i = 0;
+   }
+   i += Tail;
+   return Segment(i >> SEGMENTBITS)[i & SegmentMask];
+}
+
+
+template <typename TX, int SEGMENTBITS>
+TX * SegmentedQueue<TX, SEGMENTBITS>::GetSegment(int s, int & n) {
+   // Get pointer to the objects in segment s, counting from the tail.
+   // n receives the number of valid objects in it. Segment 0 begins at the
+   // tail, so it contains the objects with index 0 to n-1. Segment s > 0
+   // contains the objects with index s*SegmentSize-Tail to s*SegmentSize-Tail+n-1
+   if ((unsigned int)s >= (unsigned int)GetNumSegments()) {
+      Error(1, s);  n = 0;
+      return 0;
+   }
+   int first = s == 0 ? Tail : 0;               // Position of first object in segment
+   n = Tail + NumEntries - (s << SEGMENTBITS);
+   if (n > SegmentSize) n = SegmentSize;
+   n -= first;
+   return Segment(s) + first;
+}
+
+
+// Produce fatal error message. Used internally.
+// Note: If your program has a graphical user interface (GUI) then you
+// must rewrite this function to produce a message box with the error message.
+template <typename TX, int SEGMENTBITS>
+void SegmentedQueue<TX, SEGMENTBITS>::Error(int e, int n) {
+   // Define error texts
+   static const char * ErrorTexts[] = {
+      "Unknown error",                 // 0
+      "Index out of range",            // 1
+      "Queue is empty",                // 2
+      "Memory allocation failed"       // 3
+   };
+   // Number of texts in ErrorTexts
+   const unsigned int NumErrorTexts = sizeof(ErrorTexts) / sizeof(*ErrorTexts);
+
+   // check that index is within range
+   if ((unsigned int)e >= NumErrorTexts) e = 0;
+
+   // Replace this with your own error routine, possibly with a message box:
+   fprintf(stderr, "\nSegmentedQueue error: %s (%i)\n", ErrorTexts[e], n);
+
+   // Terminate execution
+   exit(1);
+}
+
+
+/******************************************************************************
+Example part. Remove this from final application:
+******************************************************************************/
+
+// The benchmark compares with DynamicArray from DynamicArray.cpp.
+// Its example main function is renamed so that this file has only one main:
+#define main DynamicArrayExample
+#include "DynamicArray.cpp"
+#undef main
+
+#include <time.h>                                // Needed for example only
+
+// Push NumObjects integers in batches and find the slowest batch.
+// The slowest batch is the one where DynamicArray re-allocates the most
+template <typename ARRAY>
+void GrowthBenchmark(ARRAY & list, const char * Name) {
+   const int NumObjects = 25 << 20;              // 100 MB of int
+   const int BatchSize = 1 << 16;
+   double MaxTime = 0.;
+   clock_t start = clock();
+   for (int i = 0; i < NumObjects; i += BatchSize) {
+      clock_t t0 = clock();
+      for (int k = 0; k < BatchSize; k++) list.Push(i + k);
+      double t = double(clock() - t0) / CLOCKS_PER_SEC;
+      if (t > MaxTime) MaxTime = t;
+   }
+   double Total = double(clock() - start) / CLOCKS_PER_SEC;
+   printf("\n%-15s total %7.3f s, slowest batch of %i pushes %8.3f ms, capacity %5.0f MB",
+      Name, Total, BatchSize, MaxTime * 1000., list.GetMaxNum() * 4. / (1 << 20));
+}
+
+int main() {
+   int i;                              // Loop counter
+
+   // Make instance of SegmentedArray containing objects of type int:
+   SegmentedArray<int> list;
+
+   // Put data into top of the list, one by one
+   list.Push(51);                      // list[0] = 51;
+   list.Push(52);                      // list[1] = 52;
+   list.Push(53);                      // list[2] = 53;
+
+   // A pointer to an object stays valid when the array grows
+   int * p = &list[1];
+   for (i = 0; i < 10000; i++) list.Push(i);
+
+   // Output the first entries
+   for (i = 0; i < 3; i++) {
+      printf("\n%2i:  %5i", i, list[i]);
+   }
+   printf("\n    %5i", *p);
+
+   // Fast loop through all entries, one segment at a time
+   long long sum = 0;
+   for (int s = 0; s < list.GetNumSegments(); s++) {
+      int n;
+      int * seg = list.GetSegment(s, n);
+      for (i = 0; i < n; i++) sum += seg[i];
+   }
+   printf("\nSum: %lli\n", sum);
+
+   // Queue
+   SegmentedQueue<int> queue;
+   queue.Put(10);
+   queue.Put(20);
+   queue.Put(30);
+
+   // Fast loop through all entries in the queue, one segment at a time
+   sum = 0;
+   for (int s = 0; s < queue.GetNumSegments(); s++) {
+      int n;
+      int * seg = queue.GetSegment(s, n);
+      for (i = 0; i < n; i++) sum += seg[i];
+   }
+   printf("\nQueue sum: %lli\n", sum);
+
+   // Remove entries, First-In-First-Out
+   while (queue.GetNum()) {
+      printf("\n     %5i", queue.Get());
+   }
+   printf("\n");
+
+   // Benchmark growth
+   {
+      DynamicArray<int> a;
+      GrowthBenchmark(a, "DynamicArray");
+   }
+   {
+      SegmentedArray<int, 16> a;
+      GrowthBenchmark(a, "SegmentedArray");
+   }
+   printf("\n");
+
+   return 0;
+}
@@ -1,7 +1,7 @@
 /**************************  SortedList.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2008-06-12
-* Last modified: 2008-06-12
+* Last modified: 2026-10-19
 * Description:
 * Template class for a sorted and searchable list
 *
@@ -28,6 +28,17 @@
 * moved every time a new object is added. A binary tree or hash map is more
 * efficient for large lists.
 *
+* Search uses SIMD compare instructions for the last part of the search when
+* OBJTYPE is a signed or unsigned integer of 4 or 8 bytes, float or double
+* and the code is compiled for AVX2 or AVX512 (e.g. -mavx2 or /arch:AVX2).
+* long and unsigned long use the version for the integer type of the same
+* size. The binary search stops when less than
+* SortedListSimd<OBJTYPE>::Limit records remain (16 - 64 depending on type and
+* instruction set), and the remaining records are compared with x all at
+* once. A small list is searched without any binary search at
+* all. This avoids the unpredictable branches of the binary search. Other
+* types can be added by specializing the template SortedListSimd.
+*
 * If objects are big then it may be faster to store pointers or array indices
 * to the objects in a sorted list than storing the objects themselves.
 *
@@ -41,12 +52,215 @@ Header part. Put this in a .h file:
 
 #include <string.h>                    // For strcmp
 #include <stdio.h>                     // Needed for example only
+#include <stdlib.h>                    // Needed for example only
+#include <time.h>                      // Needed for example only
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>                 // For SIMD search
+#endif
+
+
+// SortedListSimd<OBJTYPE>::CountLess(list, n, x) counts the records less than
+// x in list[0..n-1] with SIMD compare instructions. Supported is 0 for types
+// that have no SIMD search, so that the compiler removes it from Search.
+// Limit is the number of records below which SIMD compare is faster than
+// continuing the binary search.
+template <typename OBJTYPE>
+struct SortedListSimd {
+   enum {Supported = 0, Limit = 0};
+   static unsigned int CountLess(OBJTYPE const *, unsigned int, OBJTYPE const &) {
+      return 0;
+   }
+};
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+
+// SortedListSimdVector<OBJTYPE, LESS> is the SIMD version for 4-byte and
+// 8-byte types. LESS is one of the compare traits below for the size of
+// OBJTYPE. The records are loaded as integer vectors and LESS compares them
+// as signed, unsigned or floating point numbers
+
+// Horizontal sum of 32-bit and 64-bit integers
+static inline unsigned int SortedListSum32(__m256i sum) {
+   __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+   s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+   s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+   return (unsigned int)_mm_cvtsi128_si32(s);
+}
+static inline unsigned int SortedListSum64(__m256i sum) {
+   __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+   s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+   return (unsigned int)_mm_cvtsi128_si32(s);
+}
+
+#endif
+
+#if defined(__AVX512F__)
+
+// AVX512 versions. SortedListLess...<size>::Less(m, a, b) gives a mask of
+// the elements in m where a < b. The mask is 16 bits for both sizes so that
+// SortedListSimdVector has only one type of mask.
+
+template <int SIZE> struct SortedListLessSigned;
+template <> struct SortedListLessSigned<4> {
+   static __mmask16 Less(__mmask16 m, __m512i a, __m512i b) {return _mm512_mask_cmplt_epi32_mask(m, a, b);}
+};
+template <> struct SortedListLessSigned<8> {
+   static __mmask16 Less(__mmask16 m, __m512i a, __m512i b) {return _mm512_mask_cmplt_epi64_mask((__mmask8)m, a, b);}
+};
+
+template <int SIZE> struct SortedListLessUnsigned;
+template <> struct SortedListLessUnsigned<4> {
+   static __mmask16 Less(__mmask16 m, __m512i a, __m512i b) {return _mm512_mask_cmplt_epu32_mask(m, a, b);}
+};
+template <> struct SortedListLessUnsigned<8> {
+   static __mmask16 Less(__mmask16 m, __m512i a, __m512i b) {return _mm512_mask_cmplt_epu64_mask((__mmask8)m, a, b);}
+};
+
+template <int SIZE> struct SortedListLessFloat;
+template <> struct SortedListLessFloat<4> {
+   static __mmask16 Less(__mmask16 m, __m512i a, __m512i b) {
+      return _mm512_mask_cmp_ps_mask(m, _mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_LT_OQ);
+   }
+};
+template <> struct SortedListLessFloat<8> {
+   static __mmask16 Less(__mmask16 m, __m512i a, __m512i b) {
+      return _mm512_mask_cmp_pd_mask((__mmask8)m, _mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_LT_OQ);
+   }
+};
+
+// Counts 16 or 8 records at a time. The last records are loaded with a mask.
+// The sum is reduced by hand because _mm512_reduce_add and
+// _mm512_castsi512_si256 give uninitialized warnings with some compilers
+template <typename OBJTYPE, typename LESS>
+struct SortedListSimdVector {
+   enum {Supported = 1, Limit = sizeof(OBJTYPE) == 4 ? 64 : 32};
+   static unsigned int CountLess(OBJTYPE const * list, unsigned int n, OBJTYPE const & x) {
+      __m512i sum = _mm512_setzero_si512();
+      unsigned int i = 0;
+      if (sizeof(OBJTYPE) == 4) {
+         int xi;  memcpy(&xi, &x, 4);
+         __m512i xv  = _mm512_set1_epi32(xi);
+         __m512i one = _mm512_set1_epi32(1);
+         for (; i + 16 <= n; i += 16) {
+            __mmask16 lt = LESS::Less(0xFFFF, _mm512_loadu_si512(list + i), xv);
+            sum = _mm512_mask_add_epi32(sum, lt, sum, one);
+         }
+         __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+         __mmask16 lt = LESS::Less(m, _mm512_maskz_loadu_epi32(m, list + i), xv);
+         sum = _mm512_mask_add_epi32(sum, lt, sum, one);
+         return SortedListSum32(_mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xF, sum, 0), _mm512_maskz_extracti64x4_epi64(0xF, sum, 1)));
+      }
+      else {
+         long long xl;  memcpy(&xl, &x, 8);
+         __m512i xv  = _mm512_set1_epi64(xl);
+         __m512i one = _mm512_set1_epi64(1);
+         for (; i + 8 <= n; i += 8) {
+            __mmask8 lt = (__mmask8)LESS::Less(0xFF, _mm512_loadu_si512(list + i), xv);
+            sum = _mm512_mask_add_epi64(sum, lt, sum, one);
+         }
+         __mmask8 m = (__mmask8)((1u << (n - i)) - 1);
+         __mmask8 lt = (__mmask8)LESS::Less(m, _mm512_maskz_loadu_epi64(m, list + i), xv);
+         sum = _mm512_mask_add_epi64(sum, lt, sum, one);
+         return SortedListSum64(_mm256_add_epi64(_mm512_maskz_extracti64x4_epi64(0xF, sum, 0), _mm512_maskz_extracti64x4_epi64(0xF, sum, 1)));
+      }
+   }
+};
+
+#elif defined(__AVX2__)
+
+// AVX2 versions. SortedListLess...<size>::Less(a, b) gives -1 in each element
+// where a < b. Unsigned integers are compared as signed integers with the sign
+// bit flipped.
+
+template <int SIZE> struct SortedListLessSigned;
+template <> struct SortedListLessSigned<4> {
+   static __m256i Less(__m256i a, __m256i b) {return _mm256_cmpgt_epi32(b, a);}
+};
+template <> struct SortedListLessSigned<8> {
+   static __m256i Less(__m256i a, __m256i b) {return _mm256_cmpgt_epi64(b, a);}
+};
+
+template <int SIZE> struct SortedListLessUnsigned;
+template <> struct SortedListLessUnsigned<4> {
+   static __m256i Less(__m256i a, __m256i b) {
+      __m256i sign = _mm256_set1_epi32((int)0x80000000);
+      return _mm256_cmpgt_epi32(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+   }
+};
+template <> struct SortedListLessUnsigned<8> {
+   static __m256i Less(__m256i a, __m256i b) {
+      __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+      return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+   }
+};
+
+template <int SIZE> struct SortedListLessFloat;
+template <> struct SortedListLessFloat<4> {
+   static __m256i Less(__m256i a, __m256i b) {
+      return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_LT_OQ));
+   }
+};
+template <> struct SortedListLessFloat<8> {
+   static __m256i Less(__m256i a, __m256i b) {
+      return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_LT_OQ));
+   }
+};
+
+// Counts 8 or 4 records at a time. A compare gives -1 for true, which is
+// subtracted from the sum. The last records are compared one by one
+template <typename OBJTYPE, typename LESS>
+struct SortedListSimdVector {
+   enum {Supported = 1, Limit = sizeof(OBJTYPE) == 4 ? 32 : 16};
+   static unsigned int CountLess(OBJTYPE const * list, unsigned int n, OBJTYPE const & x) {
+      __m256i sum = _mm256_setzero_si256();
+      unsigned int i = 0, count;
+      if (sizeof(OBJTYPE) == 4) {
+         int xi;  memcpy(&xi, &x, 4);
+         __m256i xv = _mm256_set1_epi32(xi);
+         for (; i + 8 <= n; i += 8) {
+            sum = _mm256_sub_epi32(sum, LESS::Less(_mm256_loadu_si256((__m256i const *)(list + i)), xv));
+         }
+         count = SortedListSum32(sum);
+      }
+      else {
+         long long xl;  memcpy(&xl, &x, 8);
+         __m256i xv = _mm256_set1_epi64x(xl);
+         for (; i + 4 <= n; i += 4) {
+            sum = _mm256_sub_epi64(sum, LESS::Less(_mm256_loadu_si256((__m256i const *)(list + i)), xv));
+         }
+         count = SortedListSum64(sum);
+      }
+      for (; i < n; i++) count += (unsigned int)(list[i] < x);
+      return count;
+   }
+};
+
+#endif
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+
+// long and unsigned long are 4 bytes on some platforms and 8 bytes on others
+template <> struct SortedListSimd<int>                : SortedListSimdVector<int,                SortedListLessSigned<sizeof(int)> > {};
+template <> struct SortedListSimd<long>               : SortedListSimdVector<long,               SortedListLessSigned<sizeof(long)> > {};
+template <> struct SortedListSimd<long long>          : SortedListSimdVector<long long,          SortedListLessSigned<sizeof(long long)> > {};
+template <> struct SortedListSimd<unsigned int>       : SortedListSimdVector<unsigned int,       SortedListLessUnsigned<sizeof(unsigned int)> > {};
+template <> struct SortedListSimd<unsigned long>      : SortedListSimdVector<unsigned long,      SortedListLessUnsigned<sizeof(unsigned long)> > {};
+template <> struct SortedListSimd<unsigned long long> : SortedListSimdVector<unsigned long long, SortedListLessUnsigned<sizeof(unsigned long long)> > {};
+template <> struct SortedListSimd<float>              : SortedListSimdVector<float,              SortedListLessFloat<sizeof(float)> > {};
+template <> struct SortedListSimd<double>             : SortedListSimdVector<double,             SortedListLessFloat<sizeof(double)> > {};
+
+#endif
 
 
 // Template for sorted list
 template <typename OBJTYPE, unsigned int MAXSIZE>
 class SortedList {
 protected:
+   // Size of search interval where binary search stops
+   enum DefineSize {
+      SimdLimit = SortedListSimd<OBJTYPE>::Limit
+   };
    unsigned int num;                   // Number of objects in list
    OBJTYPE list[MAXSIZE];              // Storage buffer
 public:
@@ -80,7 +294,7 @@ public:
       unsigned int b = num;            // End of search interval + 1
       unsigned int c = 0;              // Middle of search interval
       // Binary search loop:
-      while (a < b) {
+      while (b - a > (unsigned int)SimdLimit) {
          c = (a + b) / 2;
          if (list[c] < x) {
             a = c + 1;
@@ -89,6 +303,10 @@ public:
             b = c;
          }
       }
+      if (SortedListSimd<OBJTYPE>::Supported) {
+         // Count the remaining records less than x with SIMD compare
+         a += SortedListSimd<OBJTYPE>::CountLess(list + a, b - a, x);
+      }
       return a;                        // Result of search
    }
 
@@ -188,6 +406,42 @@ struct SRecord {
 };
 
 
+// Plain binary search, for comparison with SortedList::Search
+template <typename OBJTYPE, unsigned int MAXSIZE>
+unsigned int BinarySearch(SortedList<OBJTYPE, MAXSIZE> & list, OBJTYPE const & x) {
+   unsigned int a = 0, b = list.NumRecords();
+   while (a < b) {
+      unsigned int c = (a + b) / 2;
+      if (list[c] < x) a = c + 1;
+      else b = c;
+   }
+   return a;
+}
+
+// Time Search in a small list with records of type T
+template <typename T>
+void BenchmarkSearch(const char * TypeName, unsigned int n) {
+   const unsigned int Repeat = 10000000;
+   static SortedList<T, 64> list;
+   T keys[256];                        // Values to search for
+   unsigned int i, sum1 = 0, sum2 = 0;
+   while (list.NumRecords()) list.Remove(0);
+   for (i = 0; i < n; i++) list.Put(T(rand() % 10000));
+   for (i = 0; i < 256; i++) keys[i] = T(rand() % 10000);
+
+   clock_t start = clock();
+   for (i = 0; i < Repeat; i++) sum1 += list.Search(keys[i & 255]);
+   double t1 = double(clock() - start) / CLOCKS_PER_SEC;
+
+   start = clock();
+   for (i = 0; i < Repeat; i++) sum2 += BinarySearch(list, keys[i & 255]);
+   double t2 = double(clock() - start) / CLOCKS_PER_SEC;
+
+   printf("\n%-10s %3u records: Search %6.3f s, binary search %6.3f s%s",
+      TypeName, n, t1, t2, sum1 == sum2 ? "" : "  ERROR");
+}
+
+
 // Main function. Test sorted list:
 int main() {
 
@@ -219,5 +473,16 @@ int main() {
    else {
       printf("\n\n%s not found", NameToFind);
    }
+
+   // Benchmark search in small lists
+   printf("\n\nSIMD search %s:", SortedListSimd<int>::Supported ? "enabled" : "not enabled");
+   for (i = 8; i <= 64; i *= 2) {
+      BenchmarkSearch<int>("int", i);
+      BenchmarkSearch<unsigned int>("unsigned", i);
+      BenchmarkSearch<long long>("long long", i);
+      BenchmarkSearch<float>("float", i);
+      BenchmarkSearch<double>("double", i);
+   }
+   printf("\n");
    return 0;
 }
@@ -0,0 +1,745 @@
+/**************************  SortedTree.cpp   *********************************
+* Author:        cppexamples contributors. Based on SortedList by Agner Fog
+* Date created:  2026-10-19
+* Last modified: 2026-10-19
+* Description:
+* Template class for a sorted and searchable list stored as a B+-tree
+*
+* (c) 2026 GNU General Public License www.gnu.org/copyleft/gpl.html
+*******************************************************************************
+*
+* SortedTree has the same interface as SortedList in SortedList.cpp:
+* Search, Put, PutUnique, Remove, Exists, NumRecords and operator [], where
+* records are identified by their index in sorted order. Use SortedTree
+* instead of SortedList when the list is big.
+*
+* SortedList keeps all records in one array, so every Put and Remove moves
+* half the array on average. SortedTree keeps the records in small sorted
+* leaves of LEAFSIZE records, with a tree of nodes of up to FANOUT children
+* above them. Each node stores the number of records under each child so that
+* records can still be found by index. Put, Remove, Search and operator [] all
+* take O(log n) time, and Put and Remove only move records within one leaf.
+*
+* Search is not faster than the binary search of SortedList. In the benchmark
+* at the end of this file it takes about the same time with AVX2, and 10-30%
+* longer without AVX2. Use SortedTree for the fast Put and Remove.
+*
+* Search has no branches that depend on the data. The separators in a node
+* are compared with AVX2 instructions when OBJTYPE is a 4 or 8 byte integer
+* or floating point type and AVX2 is enabled, otherwise by a binary search
+* with a fixed number of steps. The leaves are always searched by a binary
+* search with a fixed number of steps. All cache lines of the next node or
+* leaf are prefetched as soon as it is known, before its keys are compared.
+*
+* The maximum size is defined at compile time. All leaves and nodes are
+* allocated inside the object, so a SortedTree with a big MAXSIZE should be
+* static or allocated with new. Leaves and nodes other than the root are
+* always at least half full, so the storage used is at most approximately
+* twice MAXSIZE records.
+*
+* The elements can be of any type that do not require a constructor or
+* destructor. If OBJTYPE is not a simple type then you must define the
+* operator < for operands of type const OBJTYPE &, as for SortedList. Two
+* records a and b are assumed to be equal if !(a < b || b < a).
+*
+* LEAFSIZE must be at least 4 and FANOUT must be at least 6.
+*
+* SortedTree is not thread safe.
+*
+* An example of how to use SortedTree is provided at the end of this file,
+* including a benchmark against SortedList.
+*
+******************************************************************************/
+
+/******************************************************************************
+Header part. Put this in a .h file:
+******************************************************************************/
+
+#include <string.h>                    // For memcpy and memmove
+#include <stdio.h>                     // Needed for example only
+#include <stdlib.h>                    // Needed for example only
+#include <time.h>                      // Needed for example only
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>                 // For _mm_prefetch
+#define SORTEDTREE_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+#define SORTEDTREE_PREFETCH(p)
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>                 // For SIMD search in nodes
+#endif
+
+
+// SortedTreeSimd<OBJTYPE>::CountLess(key, count, n, max, x, before) counts
+// the keys less than x in key[0..n-1] and adds count[k] to before for each
+// key[k] less than x. max is a compile-time bound on n, so that the loop has a
+// fixed number of iterations. Keys beyond n are not read. Supported is 0 for
+// types that have no SIMD version, so that the compiler removes it from the
+// search.
+template <typename OBJTYPE>
+struct SortedTreeSimd {
+   enum {Supported = 0};
+   static unsigned int CountLess(OBJTYPE const *, unsigned int const *, unsigned int, unsigned int, OBJTYPE const &, unsigned int &) {
+      return 0;
+   }
+};
+
+#if defined(__AVX2__)
+
+// AVX2 versions for 4-byte and 8-byte integer and floating point types.
+// SortedTreeLess...<size>::Less(a, b) gives -1 in each element where a < b
+
+template <int SIZE> struct SortedTreeLessSigned;
+template <> struct SortedTreeLessSigned<4> {
+   static __m256i Less(__m256i a, __m256i b) {return _mm256_cmpgt_epi32(b, a);}
+};
+template <> struct SortedTreeLessSigned<8> {
+   static __m256i Less(__m256i a, __m256i b) {return _mm256_cmpgt_epi64(b, a);}
+};
+
+// Unsigned compare is signed compare with the sign bits flipped
+template <int SIZE> struct SortedTreeLessUnsigned;
+template <> struct SortedTreeLessUnsigned<4> {
+   static __m256i Less(__m256i a, __m256i b) {
+      __m256i sign = _mm256_set1_epi32((int)0x80000000);
+      return _mm256_cmpgt_epi32(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+   }
+};
+template <> struct SortedTreeLessUnsigned<8> {
+   static __m256i Less(__m256i a, __m256i b) {
+      __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+      return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+   }
+};
+
+template <int SIZE> struct SortedTreeLessFloat;
+template <> struct SortedTreeLessFloat<4> {
+   static __m256i Less(__m256i a, __m256i b) {
+      return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_LT_OQ));
+   }
+};
+template <> struct SortedTreeLessFloat<8> {
+   static __m256i Less(__m256i a, __m256i b) {
+      return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_LT_OQ));
+   }
+};
+
+// Compares 8 or 4 keys at a time. The keys and counts are loaded with a mask
+// so that nothing is read beyond key[n-1]. The number of keys less than x is
+// counted by subtracting the compare results
+template <typename OBJTYPE, typename LESS>
+struct SortedTreeSimdAVX2 {
+   enum {Supported = 1};
+   static unsigned int CountLess(OBJTYPE const * key, unsigned int const * count, unsigned int n, unsigned int max, OBJTYPE const & x, unsigned int & before) {
+      __m256i less = _mm256_setzero_si256();   // Number of keys < x
+      __m256i sum  = _mm256_setzero_si256();   // Sum of counts
+      unsigned int i;
+      if (sizeof(OBJTYPE) == 4) {
+         int xi;  memcpy(&xi, &x, 4);
+         __m256i xv = _mm256_set1_epi32(xi);
+         for (i = 0; i < max; i += 8) {
+            __m256i inside = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n - (int)i), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i v = _mm256_maskload_epi32((int const *)(key + i), inside);
+            __m256i lt = _mm256_and_si256(LESS::Less(v, xv), inside);
+            less = _mm256_sub_epi32(less, lt);
+            sum = _mm256_add_epi32(sum, _mm256_and_si256(lt, _mm256_maskload_epi32((int const *)(count + i), inside)));
+         }
+         // Add the two sums together before the horizontal add
+         sum = _mm256_add_epi32(_mm256_unpacklo_epi32(less, sum), _mm256_unpackhi_epi32(less, sum));
+         __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+         s = _mm_add_epi32(s, _mm_unpackhi_epi64(s, s));
+         before += (unsigned int)_mm_extract_epi32(s, 1);
+         return (unsigned int)_mm_cvtsi128_si32(s);
+      }
+      else {
+         long long xl;  memcpy(&xl, &x, 8);
+         __m256i xv = _mm256_set1_epi64x(xl);
+         for (i = 0; i < max; i += 4) {
+            __m256i inside = _mm256_cmpgt_epi64(_mm256_set1_epi64x((int)n - (int)i), _mm256_setr_epi64x(0, 1, 2, 3));
+            __m128i inside4 = _mm_cmpgt_epi32(_mm_set1_epi32((int)n - (int)i), _mm_setr_epi32(0, 1, 2, 3));
+            __m256i v = _mm256_maskload_epi64((long long const *)(key + i), inside);
+            __m256i lt = _mm256_and_si256(LESS::Less(v, xv), inside);
+            less = _mm256_sub_epi64(less, lt);
+            __m256i c = _mm256_cvtepu32_epi64(_mm_maskload_epi32((int const *)(count + i), inside4));
+            sum = _mm256_add_epi64(sum, _mm256_and_si256(lt, c));
+         }
+         sum = _mm256_add_epi64(_mm256_unpacklo_epi64(less, sum), _mm256_unpackhi_epi64(less, sum));
+         __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+         before += (unsigned int)_mm_extract_epi32(s, 2);
+         return (unsigned int)_mm_cvtsi128_si32(s);
+      }
+   }
+};
+
+template <> struct SortedTreeSimd<int>                : SortedTreeSimdAVX2<int,                SortedTreeLessSigned<sizeof(int)> > {};
+template <> struct SortedTreeSimd<long>               : SortedTreeSimdAVX2<long,               SortedTreeLessSigned<sizeof(long)> > {};
+template <> struct SortedTreeSimd<long long>          : SortedTreeSimdAVX2<long long,          SortedTreeLessSigned<sizeof(long long)> > {};
+template <> struct SortedTreeSimd<unsigned int>       : SortedTreeSimdAVX2<unsigned int,       SortedTreeLessUnsigned<sizeof(unsigned int)> > {};
+template <> struct SortedTreeSimd<unsigned long>      : SortedTreeSimdAVX2<unsigned long,      SortedTreeLessUnsigned<sizeof(unsigned long)> > {};
+template <> struct SortedTreeSimd<unsigned long long> : SortedTreeSimdAVX2<unsigned long long, SortedTreeLessUnsigned<sizeof(unsigned long long)> > {};
+template <> struct SortedTreeSimd<float>              : SortedTreeSimdAVX2<float,              SortedTreeLessFloat<sizeof(float)> > {};
+template <> struct SortedTreeSimd<double>             : SortedTreeSimdAVX2<double,             SortedTreeLessFloat<sizeof(double)> > {};
+
+#endif
+
+
+// SortedTreeFloorPow2<N>::Value is the largest power of 2 <= N. It is the
+// first step of a binary search with a fixed number of steps over N + 1
+// positions
+template <unsigned int N> struct SortedTreeFloorPow2 {
+   enum {Value = 2 * SortedTreeFloorPow2<N / 2>::Value};
+};
+template <> struct SortedTreeFloorPow2<1> {
+   enum {Value = 1};
+};
+
+
+// Template for sorted list stored as B+-tree
+template <typename OBJTYPE, unsigned int MAXSIZE, unsigned int LEAFSIZE = 32, unsigned int FANOUT = 16>
+class SortedTree {
+protected:
+   // Sizes of leaf and node pools
+   enum DefineSize {
+      LeafMin = LEAFSIZE / 2 - 1,      // Minimum number of records in a leaf other than the root
+      NodeMin = FANOUT / 2 - 1,        // Minimum number of children of a node other than the root
+      NodeStep = SortedTreeFloorPow2<FANOUT - 1>::Value,  // First step of binary search in node, child 0 to FANOUT-1
+      LeafStep = SortedTreeFloorPow2<LEAFSIZE>::Value,    // First step of binary search in leaf, position 0 to LEAFSIZE
+      MaxLeaves = MAXSIZE / LeafMin + 2,          // Maximum number of leaves in use
+      MaxNodes = MaxLeaves / (NodeMin - 1) + 32   // Maximum number of nodes in use
+   };
+   struct Leaf {
+      unsigned int n;                  // Number of records in leaf
+      OBJTYPE list[LEAFSIZE];          // Sorted records
+   };
+   struct Node {
+      unsigned int n;                  // Number of children
+      OBJTYPE key[FANOUT];             // key[j] separates child j-1 and child j. key[0] is not used
+      unsigned int child[FANOUT];      // Index of child node, or leaf in the lowest level
+      unsigned int count[FANOUT];      // Number of records under each child
+   };
+   unsigned int num;                   // Number of records in list
+   unsigned int height;                // Number of node levels above the leaves
+   unsigned int root;                  // Root node, or root leaf if height = 0
+   unsigned int numFreeLeaves;         // Number of unused leaves
+   unsigned int numFreeNodes;          // Number of unused nodes
+   unsigned int freeLeaves[MaxLeaves]; // Stack of unused leaves
+   unsigned int freeNodes[MaxNodes];   // Stack of unused nodes
+   Leaf leaves[MaxLeaves];             // Leaf storage
+   Node nodes[MaxNodes];               // Node storage
+
+   // Prefetch all cache lines of a leaf or node so that the misses overlap
+   static void Prefetch(const void * p, unsigned int size) {
+      for (unsigned int k = 0; k < size; k += 64) {
+         SORTEDTREE_PREFETCH((const char*)p + k);
+      }
+   }
+
+   // Index of the child that contains the first record >= x.
+   // before receives the number of records in the children before it.
+   // The separators are compared with SIMD instructions if possible,
+   // otherwise by a binary search with a fixed number of steps. There are
+   // no branches that depend on the data
+   static unsigned int ChildBelow(Node const & nd, OBJTYPE const & x, unsigned int & before) {
+      before = 0;
+      if (SortedTreeSimd<OBJTYPE>::Supported) {
+         return SortedTreeSimd<OBJTYPE>::CountLess(nd.key + 1, nd.count, nd.n - 1, FANOUT - 1, x, before);
+      }
+      unsigned int j = 0;
+      for (unsigned int step = NodeStep; step > 0; step /= 2) {
+         unsigned int k = j + step;
+         j = (k < nd.n && nd.key[k] < x) ? k : j;
+      }
+      for (unsigned int k = 0; k < j; k++) before += nd.count[k];
+      return j;
+   }
+
+   // Index of the first record >= x in a leaf, or n if none.
+   // Binary search with a fixed number of steps and no branches
+   static unsigned int LeafSearch(Leaf const & lf, OBJTYPE const & x) {
+      unsigned int i = 0;
+      for (unsigned int step = LeafStep; step > 0; step /= 2) {
+         unsigned int k = i + step;
+         i = (k <= lf.n && lf.list[k-1] < x) ? k : i;
+      }
+      return i;
+   }
+
+   unsigned int NewLeaf() {
+      unsigned int i = freeLeaves[--numFreeLeaves];
+      leaves[i].n = 0;
+      return i;
+   }
+
+   unsigned int NewNode() {
+      unsigned int i = freeNodes[--numFreeNodes];
+      nodes[i].n = 0;
+      return i;
+   }
+
+   void FreeLeaf(unsigned int i) {
+      freeLeaves[numFreeLeaves++] = i;
+   }
+
+   void FreeNode(unsigned int i) {
+      freeNodes[numFreeNodes++] = i;
+   }
+
+   // Number of children or records of a child in level h
+   unsigned int ChildSize(unsigned int c, unsigned int h) {
+      return h > 1 ? nodes[c].n : leaves[c].n;
+   }
+
+   // Insert a child at position pos in a node that is not full
+   static void InsertChild(Node & nd, unsigned int pos, unsigned int c, OBJTYPE const & key, unsigned int count) {
+      unsigned int m = nd.n - pos;
+      memmove(nd.key + pos + 1, nd.key + pos, m * sizeof(OBJTYPE));
+      memmove(nd.child + pos + 1, nd.child + pos, m * sizeof(unsigned int));
+      memmove(nd.count + pos + 1, nd.count + pos, m * sizeof(unsigned int));
+      nd.key[pos] = key;
+      nd.child[pos] = c;
+      nd.count[pos] = count;
+      nd.n++;
+   }
+
+   // Remove the child at position pos from a node
+   static void RemoveChild(Node & nd, unsigned int pos) {
+      unsigned int m = nd.n - pos - 1;
+      memmove(nd.key + pos, nd.key + pos + 1, m * sizeof(OBJTYPE));
+      memmove(nd.child + pos, nd.child + pos + 1, m * sizeof(unsigned int));
+      memmove(nd.count + pos, nd.count + pos + 1, m * sizeof(unsigned int));
+      nd.n--;
+   }
+
+   // Split the full child j of node nd in level h into two halves
+   void SplitChild(Node & nd, unsigned int j, unsigned int h) {
+      if (h == 1) {
+         Leaf & a = leaves[nd.child[j]];
+         unsigned int bi = NewLeaf();
+         Leaf & b = leaves[bi];
+         unsigned int half = a.n / 2;
+         b.n = a.n - half;
+         memcpy(b.list, a.list + half, b.n * sizeof(OBJTYPE));
+         a.n = half;
+         nd.count[j] = a.n;
+         InsertChild(nd, j + 1, bi, b.list[0], b.n);
+      }
+      else {
+         Node & a = nodes[nd.child[j]];
+         unsigned int bi = NewNode();
+         Node & b = nodes[bi];
+         unsigned int half = a.n / 2;
+         b.n = a.n - half;
+         memcpy(b.key, a.key + half, b.n * sizeof(OBJTYPE));
+         memcpy(b.child, a.child + half, b.n * sizeof(unsigned int));
+         memcpy(b.count, a.count + half, b.n * sizeof(unsigned int));
+         a.n = half;
+         unsigned int bCount = 0;
+         for (unsigned int k = 0; k < b.n; k++) bCount += b.count[k];
+         nd.count[j] -= bCount;
+         InsertChild(nd, j + 1, bi, b.key[0], bCount);
+      }
+   }
+
+   // Move the last record or child of child j-1 to the front of child j.
+   // Returns the number of records moved
+   unsigned int BorrowFromLeft(Node & nd, unsigned int j, unsigned int h) {
+      unsigned int moved;
+      if (h == 1) {
+         Leaf & l = leaves[nd.child[j-1]];
+         Leaf & c = leaves[nd.child[j]];
+         memmove(c.list + 1, c.list, c.n * sizeof(OBJTYPE));
+         c.list[0] = l.list[--l.n];
+         c.n++;
+         nd.key[j] = c.list[0];
+         moved = 1;
+      }
+      else {
+         Node & l = nodes[nd.child[j-1]];
+         Node & c = nodes[nd.child[j]];
+         l.n--;
+         InsertChild(c, 0, l.child[l.n], l.key[l.n], l.count[l.n]);
+         c.key[1] = nd.key[j];         // Old first child is now separated by the old separator
+         nd.key[j] = l.key[l.n];
+         moved = c.count[0];
+      }
+      nd.count[j-1] -= moved;
+      nd.count[j] += moved;
+      return moved;
+   }
+
+   // Move the first record or child of child j+1 to the end of child j
+   void BorrowFromRight(Node & nd, unsigned int j, unsigned int h) {
+      unsigned int moved;
+      if (h == 1) {
+         Leaf & c = leaves[nd.child[j]];
+         Leaf & r = leaves[nd.child[j+1]];
+         c.list[c.n++] = r.list[0];
+         memmove(r.list, r.list + 1, --r.n * sizeof(OBJTYPE));
+         nd.key[j+1] = r.list[0];
+         moved = 1;
+      }
+      else {
+         Node & c = nodes[nd.child[j]];
+         Node & r = nodes[nd.child[j+1]];
+         moved = r.count[0];
+         c.key[c.n] = nd.key[j+1];
+         c.child[c.n] = r.child[0];
+         c.count[c.n] = r.count[0];
+         c.n++;
+         nd.key[j+1] = r.key[1];
+         RemoveChild(r, 0);
+      }
+      nd.count[j] += moved;
+      nd.count[j+1] -= moved;
+   }
+
+   // Append child a+1 to child a and remove child a+1
+   void MergeChildren(Node & nd, unsigned int a, unsigned int h) {
+      unsigned int bi = nd.child[a+1];
+      if (h == 1) {
+         Leaf & l = leaves[nd.child[a]];
+         Leaf & r = leaves[bi];
+         memcpy(l.list + l.n, r.list, r.n * sizeof(OBJTYPE));
+         l.n += r.n;
+         FreeLeaf(bi);
+      }
+      else {
+         Node & l = nodes[nd.child[a]];
+         Node & r = nodes[bi];
+         memcpy(l.key + l.n, r.key, r.n * sizeof(OBJTYPE));
+         memcpy(l.child + l.n, r.child, r.n * sizeof(unsigned int));
+         memcpy(l.count + l.n, r.count, r.n * sizeof(unsigned int));
+         l.key[l.n] = nd.key[a+1];     // First child of r is separated by the old separator
+         l.n += r.n;
+         FreeNode(bi);
+      }
+      nd.count[a] += nd.count[a+1];
+      RemoveChild(nd, a+1);
+   }
+
+   // Make child j of nd bigger than the minimum before removing from it.
+   // Returns the new position of the child. i is the index within the child
+   unsigned int FixChild(Node & nd, unsigned int j, unsigned int h, unsigned int & i) {
+      unsigned int min = h > 1 ? (unsigned int)NodeMin : (unsigned int)LeafMin;
+      if (j > 0 && ChildSize(nd.child[j-1], h) > min) {
+         i += BorrowFromLeft(nd, j, h);
+         return j;
+      }
+      if (j + 1 < nd.n && ChildSize(nd.child[j+1], h) > min) {
+         BorrowFromRight(nd, j, h);
+         return j;
+      }
+      if (j > 0) {
+         i += nd.count[j-1];
+         MergeChildren(nd, j-1, h);
+         return j - 1;
+      }
+      if (j + 1 < nd.n) {
+         MergeChildren(nd, j, h);
+      }
+      return j;
+   }
+
+   // Find the first record >= x. Returns its index, and its leaf and position
+   unsigned int Locate(OBJTYPE const & x, unsigned int & leaf, unsigned int & pos) {
+      unsigned int index = 0;
+      unsigned int p = root;
+      for (unsigned int h = height; h > 0; h--) {
+         Node const & nd = nodes[p];
+         unsigned int before;
+         unsigned int j = ChildBelow(nd, x, before);
+         index += before;
+         p = nd.child[j];
+         // Fetch all cache lines of the child at once
+         if (h > 1) Prefetch(nodes + p, sizeof(Node));
+         else       Prefetch(leaves + p, sizeof(Leaf));
+      }
+      leaf = p;
+      pos = LeafSearch(leaves[p], x);
+      return index + pos;
+   }
+
+public:
+   // Constructor:
+   SortedTree() {
+      num = 0;                         // Initialize
+      height = 0;
+      numFreeLeaves = 0;
+      numFreeNodes = 0;
+      for (unsigned int i = MaxLeaves; i > 0; i--) FreeLeaf(i - 1);
+      for (unsigned int i = MaxNodes; i > 0; i--) FreeNode(i - 1);
+      root = NewLeaf();
+   }
+
+   // Operator [] returns the entry with index i
+   OBJTYPE & operator [] (unsigned int i) {
+      if (i >= num) {
+         // Index out of range. The next line provokes an error.
+         // You may insert any other error reporting here:
+         return *(OBJTYPE*)0;          // Return null reference
+      }
+      unsigned int p = root;
+      for (unsigned int h = height; h > 0; h--) {
+         Node const & nd = nodes[p];
+         unsigned int j = 0;
+         while (i >= nd.count[j]) i -= nd.count[j++];
+         p = nd.child[j];
+      }
+      return leaves[p].list[i];        // Return reference
+   }
+
+   // This function gets the number of records in the list:
+   unsigned int NumRecords() {
+      return num;
+   }
+
+   // This function returns an index to the first entry
+   // bigger than or equal to x. If no entry is bigger than
+   // or equal to x then the return value is num, which is
+   // not a valid index.
+   unsigned int Search(OBJTYPE const & x) {
+      unsigned int leaf, pos;
+      return Locate(x, leaf, pos);
+   }
+
+   // This function adds a new record to the list.
+   // Returns true if success, false if the list is full:
+   bool Put(OBJTYPE const & x) {
+      if (num >= MAXSIZE) {
+         return false;                 // List full
+      }
+      // Full nodes are split on the way down so that there is always
+      // room for a new child in the parent
+      if (ChildSize(root, height + 1) == (height ? FANOUT : LEAFSIZE)) {
+         unsigned int r = NewNode();
+         nodes[r].n = 1;
+         nodes[r].child[0] = root;
+         nodes[r].count[0] = num;
+         root = r;
+         height++;
+         SplitChild(nodes[r], 0, height);
+      }
+      unsigned int p = root;
+      for (unsigned int h = height; h > 0; h--) {
+         Node & nd = nodes[p];
+         unsigned int before;
+         unsigned int j = ChildBelow(nd, x, before);
+         if (ChildSize(nd.child[j], h) == (h > 1 ? FANOUT : LEAFSIZE)) {
+            SplitChild(nd, j, h);
+            if (nd.key[j+1] < x) j++;
+         }
+         nd.count[j]++;
+         p = nd.child[j];
+      }
+      // Move the records after x up one place within the leaf
+      Leaf & lf = leaves[p];
+      unsigned int a = LeafSearch(lf, x);
+      memmove(lf.list + a + 1, lf.list + a, (lf.n - a) * sizeof(OBJTYPE));
+      lf.list[a] = x;
+      lf.n++;
+      num++;                           // Increment count
+      return true;                     // Success
+   }
+
+   // This function does the same as Put, except that it does not
+   // put x into the list if an existing record is equal to x. This
+   // prevents duplicates. Returns false if the list is full:
+   bool PutUnique(OBJTYPE const & x) {
+      if (num >= MAXSIZE) {
+         return false;                 // List full
+      }
+      unsigned int i;
+      if (Exists(x, i)) {
+         return true;                  // Return without adding x
+      }
+      return Put(x);
+   }
+
+   // This function removes a record with index i from the list:
+   void Remove(unsigned int i) {
+      if (i >= num) return;            // No record with index i
+      // Children at the minimum size are filled up on the way down
+      // so that no leaf or node gets less than half full
+      unsigned int p = root;
+      for (unsigned int h = height; h > 0; h--) {
+         Node & nd = nodes[p];
+         unsigned int j = 0;
+         while (i >= nd.count[j]) i -= nd.count[j++];
+         unsigned int min = h > 1 ? (unsigned int)NodeMin : (unsigned int)LeafMin;
+         if (ChildSize(nd.child[j], h) <= min) {
+            j = FixChild(nd, j, h, i);
+         }
+         nd.count[j]--;
+         p = nd.child[j];
+      }
+      Leaf & lf = leaves[p];
+      memmove(lf.list + i, lf.list + i + 1, (lf.n - i - 1) * sizeof(OBJTYPE));
+      lf.n--;
+      num--;                           // Count down num
+      // Remove root nodes with only one child
+      while (height > 0 && nodes[root].n == 1) {
+         unsigned int r = root;
+         root = nodes[r].child[0];
+         FreeNode(r);
+         height--;
+      }
+   }
+
+   // This function tells if a record equal to x is in the list.
+   // The parameter Index will receive the index if found.
+   bool Exists(OBJTYPE const & x, unsigned int & Index) {
+      // Two records a and b are assumed to be equal if
+      // !(a < b || b < a)
+      unsigned int leaf, pos;
+      unsigned int i = Locate(x, leaf, pos);
+      if (i >= num) {
+         return false;                 // Not found
+      }
+      // The first record >= x is the first record of the next leaf if pos = n
+      OBJTYPE const & y = pos < leaves[leaf].n ? leaves[leaf].list[pos] : (*this)[i];
+      if (x < y) {
+         return false;                 // Not found
+      }
+      Index = i;
+      return true;
+   }
+};
+
+
+/******************************************************************************
+Example part. Remove this from final application:
+******************************************************************************/
+
+// The benchmark compares with SortedList from SortedList.cpp.
+// Its example main function is renamed so that this file has only one main:
+#define main SortedListExample
+#include "SortedList.cpp"
+#undef main
+
+// Random numbers for the test (xorshift, reproducible on all platforms)
+static unsigned int RandomState = 12345;
+unsigned int Random() {
+   RandomState ^= RandomState << 13;
+   RandomState ^= RandomState >> 17;
+   RandomState ^= RandomState << 5;
+   return RandomState;
+}
+
+double Seconds(clock_t start) {
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Size of benchmark. SortedList is O(n^2) for random insertions,
+// so this is kept small enough for SortedList to finish in seconds
+const unsigned int BenchSize = 100000;
+const unsigned int BenchSearches = 2000000;
+
+// Size of search benchmark with a bigger list. 4 MB of integers still fits
+// in the level 3 cache of many processors
+const unsigned int BigBenchSize = 1000000;
+
+// Lists are static because they are too big for the stack
+static SortedList<int, BenchSize> benchList;
+static SortedTree<int, BenchSize> benchTree;
+static SortedList<int, BigBenchSize> bigList;
+static SortedTree<int, BigBenchSize> bigTree;
+
+
+// Main function. Test sorted tree:
+int main() {
+
+   // Define a sorted tree with records of type SRecord, defined in
+   // SortedList.cpp, and a maximum of 1000 records:
+   static SortedTree<SRecord, 1000> list;
+
+   // Put some silly test data into the list:
+   list.Put(SRecord("Dennis", "Nowhere"));
+   list.Put(SRecord("Elsie", "Elsewhere"));
+   list.Put(SRecord("Brad", "There"));
+   list.Put(SRecord("Cecilia", "Somewhere"));
+   list.Put(SRecord("Anna", "Here"));
+
+   unsigned int i;
+   printf("\nList of records:");
+
+   // Loop through the list and print all records
+   for (i = 0; i < list.NumRecords(); i++) {
+      printf("\n%-32s %-32s", list[i].name, list[i].address);
+   }
+
+   // Search for a name in list:
+   const char * NameToFind = "Cecilia";
+
+   if (list.Exists(SRecord(NameToFind, ""), i)) {
+      printf("\n\nFound %s %s", list[i].name, list[i].address);
+   }
+   else {
+      printf("\n\n%s not found", NameToFind);
+   }
+
+   // Benchmark against SortedList
+   printf("\n\nBenchmark, %u random integers:", BenchSize);
+   clock_t start;
+   unsigned int errors = 0;
+   unsigned int sum1 = 0, sum2 = 0;
+
+   RandomState = 12345;
+   start = clock();
+   for (i = 0; i < BenchSize; i++) benchList.Put(int(Random() & 0x7FFFFFFF));
+   printf("\nPut:    SortedList %8.3f s", Seconds(start));
+
+   RandomState = 12345;
+   start = clock();
+   for (i = 0; i < BenchSize; i++) benchTree.Put(int(Random() & 0x7FFFFFFF));
+   printf("   SortedTree %8.3f s", Seconds(start));
+
+   RandomState = 999;
+   start = clock();
+   for (i = 0; i < BenchSearches; i++) sum1 += benchList.Search(int(Random() & 0x7FFFFFFF));
+   printf("\nSearch: SortedList %8.3f s", Seconds(start));
+
+   RandomState = 999;
+   start = clock();
+   for (i = 0; i < BenchSearches; i++) sum2 += benchTree.Search(int(Random() & 0x7FFFFFFF));
+   printf("   SortedTree %8.3f s", Seconds(start));
+   if (sum1 != sum2) errors++;
+
+   RandomState = 777;
+   start = clock();
+   for (i = 0; i < BenchSize / 2; i++) benchList.Remove(Random() % benchList.NumRecords());
+   printf("\nRemove: SortedList %8.3f s", Seconds(start));
+
+   RandomState = 777;
+   start = clock();
+   for (i = 0; i < BenchSize / 2; i++) benchTree.Remove(Random() % benchTree.NumRecords());
+   printf("   SortedTree %8.3f s", Seconds(start));
+
+   // Check that both lists contain the same records
+   if (benchList.NumRecords() != benchTree.NumRecords()) errors++;
+   for (i = 0; i < benchList.NumRecords(); i++) {
+      if (benchList[i] != benchTree[i]) errors++;
+   }
+
+   // Search benchmark with a big list. The records are put into SortedList
+   // in sorted order, because random insertions would take too long
+   printf("\n\nBenchmark, %u random integers:", BigBenchSize);
+   RandomState = 12345;
+   for (i = 0; i < BigBenchSize; i++) bigTree.Put(int(Random() & 0x7FFFFFFF));
+   for (i = 0; i < bigTree.NumRecords(); i++) bigList.Put(bigTree[i]);
+
+   sum1 = sum2 = 0;
+   RandomState = 999;
+   start = clock();
+   for (i = 0; i < BenchSearches; i++) sum1 += bigList.Search(int(Random() & 0x7FFFFFFF));
+   printf("\nSearch: SortedList %8.3f s", Seconds(start));
+
+   RandomState = 999;
+   start = clock();
+   for (i = 0; i < BenchSearches; i++) sum2 += bigTree.Search(int(Random() & 0x7FFFFFFF));
+   printf("   SortedTree %8.3f s", Seconds(start));
+   if (sum1 != sum2) errors++;
+   printf("\nErrors: %u\n", errors);
+   return 0;
+}
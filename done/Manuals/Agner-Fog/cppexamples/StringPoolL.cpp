@@ -1,14 +1,14 @@
 /*************************  StringPoolL.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2008-06-12
-* Last modified: 2011-07-29
+* Last modified: 2026-10-19
 * Description:
 * Defines memory pool for storing ASCII strings or UTF-8 encoded strings of 
 * arbitrary length. The length of each string is remembered.
 *
 * The latest version of this file is available at:
 * www.agner.org/optimize/cppexamples.zip
-* (c) 2008-2011 GNU General Public License www.gnu.org/copyleft/gpl.html
+* (c) 2008-2026 GNU General Public License www.gnu.org/copyleft/gpl.html
 *******************************************************************************
 *
 * This string pool is a useful replacement for string classes such as 'string' 
@@ -37,6 +37,11 @@
 * StringPoolL may optionally use the function library asmlib for fast string 
 * handling, especially fast string searching. Define USE_ASMLIB to use this.
 * The asmlib library is available at (www.agner.org/optimize/asmlib.zip) 
+* Without asmlib, SearchForSubstring uses strstr from the standard library.
+* Define USE_SIMD_SEARCH to use a built-in search with AVX2 or SSE4.2
+* instructions instead, if these are enabled in the compiler options (e.g.
+* -mavx2 or /arch:AVX2). It is faster than a simple strstr, but slower than
+* the vectorized strstr in newer versions of glibc.
 *
 * Each string is identified by an integer index. For example:
 * StringPoolL strings;
@@ -61,6 +66,26 @@
 * more than the double size and move all strings to the new block. Garbage
 * collection takes place only when a new memory block is allocated.
 *
+* Moving all strings at once can take a long time when the pool is big. Call
+* SetIncremental to avoid such pauses. In incremental mode, a new memory
+* block is allocated already when the old block is 3/4 full. The strings are
+* then moved to the new block a few at a time: each call to Set or
+* Concatenate moves a number of bytes proportional to the length of the
+* string being stored, so that the move is finished before the old block is
+* full. Strings that have not been moved yet are read from the old block.
+* This bounds the time of each operation at the cost of more memory while
+* the strings are being moved and a little extra time for each access.
+*
+* Strings can be interned with Intern. Intern returns the index of a string
+* with the same text if there is one, or stores the text as a new string
+* and returns the new index. Find tells if an interned string exists. These
+* functions use a hash table, which is allocated the first time Intern is
+* called. Each entry in the hash table contains a hash value and an index,
+* so that a string in Buffer is read only when the hash values match. The
+* indices are stable because strings are identified by index, not by offset.
+* An interned string that is later changed with Set, '=', '+=' or '[]' is
+* no longer found by Intern and Find.
+*
 * Note that you should never store a pointer to a string in the string pool
 * because the pointer will become invalid in case the assignment or
 * modification of another string causes the memory to be re-allocated.
@@ -94,6 +119,7 @@
 #include <stdlib.h>               // For exit in Error function
 #include <stdarg.h>               // For va_list, va_start
 #include <stdio.h>                // Needed for example only
+#include <chrono>                 // Needed for example only
 //#include <varargs.h>            // Include varargs.h for va_list, va_start only if required by your system
 
 #ifdef   USE_ASMLIB
@@ -110,8 +136,16 @@
 #define  strlen_  strlen
 #define  strcmp_  strcmp
 #define  strstr_  strstr
+#if defined(USE_SIMD_SEARCH) && (defined(__AVX2__) || defined(__SSE4_2__))
+#define  SIMD_SEARCH              // Use built-in SIMD substring search
+#include <immintrin.h>            // For SIMD substring search
+#endif
+#if defined(SIMD_SEARCH) && !defined(__AVX2__)
+#define  MEM_PADDING 15           // SSE4.2 search reads up to 15 bytes beyond a string
+#else
 #define  MEM_PADDING 0
 #endif
+#endif
 
 // Define pointer to zero-terminated string
 typedef char const * PChar;
@@ -169,6 +203,12 @@ public:
    void Concatenate(int i, PChar s);   // Concatenate strings. Used by StringElement 
    void ReserveBuf(unsigned int newsize);// Allocate memory for string space
    void ReserveNum(unsigned int newsize);// Allocate memory for string indices
+   void SetIncremental(unsigned int minsize = 1 << 20); // Incremental garbage collection when Buffer is bigger than minsize. 0 = off
+   int Intern(PChar s);                // Find or insert zero-terminated string. Returns index
+   int Intern(PChar s, unsigned int len);// Find or insert non zero-terminated string. Returns index
+   int Find(PChar s) const;            // Find interned string. Returns index or -1 if not found
+   int Find(PChar s, unsigned int len) const; // Same, non zero-terminated string
+   void ReserveHash(unsigned int num); // Allocate hash table for num interned strings
    LengthType Len(int i) const;        // Get length of string
 
    // Define desired allocation sizes. You may change these values:
@@ -176,7 +216,9 @@ public:
       AllocateSpace1 = 4096,           // Minimum number of characters to allocate in string buffer 
       AllocateSpace2 = 1024,           // Minimum number of indices to allocate in offsets buffer
       FormatLength   = 1023,           // Maximum length of strings written with Printf
-      MemPadding     = MEM_PADDING     // Memory buffer padding
+      MemPadding     = MEM_PADDING,    // Memory buffer padding
+      MoveQuantum    = 256,            // Minimum number of bytes moved per operation in incremental mode
+      AllocateSpace3 = 1024            // Minimum number of entries in hash table. Must be a power of 2
    };
 protected:
    char * Get(int i) const;            // Read string. Used only from StringElement 
@@ -191,6 +233,31 @@ private:
    unsigned int GarbageSize;           // Total size of garbage in Buffer
    unsigned int Top;                   // Highest used Offset
    int Num;                            // Number of strings = highest used index in Offsets + 1
+   // Incremental garbage collection:
+   char * MoveBuffer;                  // Old Buffer while strings are moved from it
+   unsigned int MoveBufferSize;        // Size of MoveBuffer
+   unsigned int MoveDataSize;          // Used part of MoveBuffer
+   unsigned int MoveTop;               // Highest used Offset in MoveBuffer
+   unsigned int MoveRate;              // Bytes to move per byte stored
+   unsigned int IncrementalMin;        // Minimum BufferSize for incremental garbage collection. 0 = off
+   int MoveNext;                       // Strings below this index are in Buffer, the rest in MoveBuffer
+   enum {MoveIdle = 0x7FFFFFFF};       // Value of MoveNext when no strings are being moved
+   char * Base(int i) const {          // Buffer containing string i
+      return i < MoveNext ? Buffer : MoveBuffer;}
+   void Collect(unsigned int len);     // Incremental garbage collection before storing len characters
+   void StartMove();                   // Start moving strings to a new Buffer
+   void Move(size_t quota);            // Move strings from MoveBuffer to Buffer
+   void ReleaseOld();                  // Release OldBuffer and MoveBuffer when no longer needed
+   // Hash table for Intern and Find:
+   struct HashEntry {
+      unsigned int Hash;               // Hash value of string
+      int Index;                       // Index of string + 1. 0 means empty entry
+   };
+   HashEntry * HashTable;              // Hash table with open addressing and linear probing
+   unsigned int HashSize;              // Number of entries in HashTable. A power of 2
+   unsigned int HashNum;               // Number of used entries in HashTable
+   static unsigned int Hash(PChar s, unsigned int len); // Hash function
+   unsigned int FindEntry(PChar s, unsigned int len, unsigned int hash) const; // Search HashTable
    char * Allocate(int i, unsigned int len); // Make space for a new string
    StringPoolL(StringPoolL &){};       // Private copy constructor to prevent copying
    void operator = (StringPoolL &){};  // Private operator = to prevent copying
@@ -226,6 +293,7 @@ inline bool operator  > (StringPoolL::StringElement const & a, StringPoolL::Stri
 StringPoolL::StringPoolL() {
    // Set everything to zero
    memset_(this, 0, sizeof(*this));
+   MoveNext = MoveIdle;
 }
 
 
@@ -234,6 +302,8 @@ StringPoolL::~StringPoolL() {
    // Free allocated memory
    if (Buffer)    delete[] Buffer;
    if (OldBuffer) delete[] OldBuffer;
+   if (MoveBuffer) delete[] MoveBuffer;
+   if (HashTable) delete[] HashTable;
    if (Offsets)   delete[] Offsets;
    // Set everything to zero
    memset_(this, 0, sizeof(*this));
@@ -244,8 +314,18 @@ StringPoolL::~StringPoolL() {
 void StringPoolL::Clear() {
    // Set all offsets to zero
    if (Offsets) memset_(Offsets, 0, Num * sizeof(*Offsets));
-   // Indicate that Buffer is empty, but do not deallocate
+   // Stop moving strings
+   if (MoveBuffer) {
+      delete[] MoveBuffer;  MoveBuffer = 0;
+   }
+   MoveNext = MoveIdle;
+   // Empty hash table
+   if (HashTable) memset_(HashTable, 0, HashSize * sizeof(*HashTable));
+   HashNum = 0;
+   // Indicate that Buffer is empty, but do not deallocate.
+   // Keep the empty string at offset 0
    DataSize = GarbageSize = 0;
+   if (Buffer) DataSize = Top = sizeof(LengthType) + 1;
 }
 
 
@@ -266,7 +346,8 @@ void StringPoolL::Set(int i, PChar s) {
    if (len == 0) {
       // Erase string
       if (Offsets[i]) {
-         GarbageSize += Len(i) + 1 + sizeof(LengthType);
+         // Garbage in MoveBuffer is not counted
+         if (i < MoveNext) GarbageSize += Len(i) + 1 + sizeof(LengthType);
          Offsets[i] = 0;
       }
       return;
@@ -275,6 +356,8 @@ void StringPoolL::Set(int i, PChar s) {
    if (len > (size_t)(LengthType)(-1)) {
       Error(5,(int)len); // Longer than max LengthType
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect((unsigned int)len);
    // Make space for string
    char * p = Allocate(i, (unsigned int)len);
    // Insert length
@@ -282,9 +365,7 @@ void StringPoolL::Set(int i, PChar s) {
    // Insert string
    memcpy_(p + sizeof(LengthType), s, len+1);
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -303,11 +384,14 @@ void StringPoolL::Set(int i, PChar s, unsigned int len) {
    if (len <= 0) {
       // Erase string
       if (Offsets[i]) {
-         GarbageSize += Len(i) + 1 + sizeof(LengthType);
+         // Garbage in MoveBuffer is not counted
+         if (i < MoveNext) GarbageSize += Len(i) + 1 + sizeof(LengthType);
          Offsets[i] = 0;
       }
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(len);
    // Make space for string
    char * p = Allocate(i, len);
    // Insert length
@@ -317,9 +401,7 @@ void StringPoolL::Set(int i, PChar s, unsigned int len) {
    // Zero-terminate
    p[len+sizeof(LengthType)] = 0;
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -343,6 +425,8 @@ void StringPoolL::Concatenate(int i, PChar s) {
       Set(i, s);
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect((unsigned int)len2);
    // Remember position of string1
    PChar string1 = Get(i);
    // Make space for combined string
@@ -353,9 +437,7 @@ void StringPoolL::Concatenate(int i, PChar s) {
    memcpy_(p + sizeof(LengthType), string1, len1);
    memcpy_(p + sizeof(LengthType) + len1, s, (unsigned int)len2 + 1);
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -364,10 +446,14 @@ void StringPoolL::ReserveBuf(unsigned int newsize) {
    int i;                              // Loop counter
    unsigned int DataSize2 = 0;         // Used part of buffer after garbage collection
    unsigned int Strlen;                // Length of current string
+   unsigned int Live = DataSize - GarbageSize; // Size of strings to copy, at most
+
+   // Strings that have not been moved yet are copied from MoveBuffer
+   if (MoveNext != MoveIdle) Live += MoveDataSize;
 
    // Decide new size
-   if (newsize < (DataSize - GarbageSize) * 2 + AllocateSpace1) {
-       newsize = (DataSize - GarbageSize) * 2 + AllocateSpace1;
+   if (newsize < Live * 2 + AllocateSpace1) {
+       newsize = Live * 2 + AllocateSpace1;
    }
    // Allocate new larger block
    char * Buffer2 = new char [newsize + 1 + sizeof(LengthType) + MemPadding];
@@ -386,7 +472,7 @@ void StringPoolL::ReserveBuf(unsigned int newsize) {
             Strlen = Len(i);
             if (Strlen) {
                // String is not empty, copy it
-               memcpy_ (Buffer2 + DataSize2, Buffer + Offsets[i], Strlen + sizeof(LengthType) + 1);
+               memcpy_ (Buffer2 + DataSize2, Base(i) + Offsets[i], Strlen + sizeof(LengthType) + 1);
                // Store new offset
                Offsets[i] = Top = DataSize2;
                // Offset to next
@@ -406,6 +492,10 @@ void StringPoolL::ReserveBuf(unsigned int newsize) {
       // contain a string being copied. Remember to delete Oldbuffer
       // after new string has been stored
       OldBuffer = Buffer;
+
+      // All strings have been moved out of MoveBuffer. It is released
+      // together with OldBuffer
+      MoveNext = MoveIdle;
    }
 
    // Save new buffer
@@ -455,7 +545,7 @@ StringPoolL::LengthType StringPoolL::Len(int i) const {
       Error(1, i);      
    }
    // Return pointer
-   return *(LengthType*)(Buffer + Offsets[i]);
+   return *(LengthType*)(Base(i) + Offsets[i]);
 }
 
 
@@ -467,7 +557,7 @@ char * StringPoolL::Get(int i) const {
       Error(1, i);      
    }
    // Return pointer
-   return Buffer + sizeof(LengthType) + Offsets[i];
+   return Base(i) + sizeof(LengthType) + Offsets[i];
 }
 
 
@@ -507,16 +597,37 @@ char * StringPoolL::Allocate(int i, unsigned int len) {
    // This is allready done by Set or Concatenate before calling Allocate:
    // if (i >= OffsetsSize) ReserveNum(i+1); 
 
+   // Size needed, including length and terminating zero
+   unsigned int size = sizeof(LengthType) + 1 + len;
+
+   if (i >= MoveNext) {
+      // String i has not been moved yet. Keep it in MoveBuffer
+      if (Offsets[i] && Offsets[i] == MoveTop && MoveTop + size <= MoveBufferSize) {
+         // This is last in MoveBuffer. Can grow without overwriting other strings
+         MoveDataSize = MoveTop + size;
+         return MoveBuffer + MoveTop;
+      }
+      if (Offsets[i] && Len(i) >= len) {
+         // New string fits into same space
+         return MoveBuffer + Offsets[i];
+      }
+      if (MoveDataSize + size <= MoveBufferSize) {
+         // Put new string at end of MoveBuffer
+         Offsets[i] = MoveTop = MoveDataSize;
+         MoveDataSize += size;
+         return MoveBuffer + MoveTop;
+      }
+      // MoveBuffer is full. This can only happen if strings are moved
+      // slower than expected. Move the rest now and continue below
+      Move((size_t)(-1));
+   }
+
    if (Offsets[i]) {
       // Index i allready has a string
-      if (Offsets[i] == Top) {
+      if (Offsets[i] == Top && Top + size <= BufferSize) {
          // This is last in Buffer. Can grow without overwriting other strings
-         if (Top + sizeof(LengthType) + 1 + len > BufferSize) {
-            // Buffer not big enough
-            ReserveBuf(Top + sizeof(LengthType) + 1 + len);
-         }
          // Reserve size
-         DataSize = Top + sizeof(LengthType) + 1 + len;
+         DataSize = Top + size;
          // Return pointer. Offsets[i] unchanged
          return Buffer + Top;
       }
@@ -532,18 +643,236 @@ char * StringPoolL::Allocate(int i, unsigned int len) {
       GarbageSize += OldLen + sizeof(LengthType) + 1;
    }
    // Put new string at end of Buffer
-   if (DataSize + sizeof(LengthType) + 1 + len > BufferSize) {
+   if (DataSize + size > BufferSize) {
       // Make Buffer bigger
-      ReserveBuf(DataSize + sizeof(LengthType) + 1 + len);
+      ReserveBuf(DataSize + size);
    }
    // New offset
    Offsets[i] = Top = DataSize;
-   DataSize += sizeof(LengthType) + 1 + len;
+   DataSize += size;
    // Return pointer
    return Buffer + Top;
 }
 
 
+// Turn on incremental garbage collection for Buffer sizes bigger than minsize.
+// minsize = 0 turns it off
+void StringPoolL::SetIncremental(unsigned int minsize) {
+   // Finish any current move before turning off
+   if (minsize == 0 && MoveNext != MoveIdle) {
+      Move((size_t)(-1));  ReleaseOld();
+   }
+   IncrementalMin = minsize;
+}
+
+
+// Incremental garbage collection. Called by Set and Concatenate before
+// storing a string of length len
+void StringPoolL::Collect(unsigned int len) {
+   if (MoveNext == MoveIdle) {
+      // Start moving strings when Buffer is 3/4 full
+      if (BufferSize < IncrementalMin || DataSize < BufferSize - BufferSize / 4 || MoveBuffer) return;
+      StartMove();
+   }
+   // Move strings in proportion to the size of the new string
+   Move((size_t)MoveRate * (len + sizeof(LengthType) + 1) + MoveQuantum);
+}
+
+
+// Allocate a new Buffer and start moving strings to it
+void StringPoolL::StartMove() {
+   // Work to do is the size of live strings plus the size of the indices
+   // that must be checked
+   unsigned int Work = DataSize - GarbageSize + Num * sizeof(*Offsets);
+   // Free space in old Buffer
+   unsigned int Free = BufferSize - DataSize;
+
+   // The move must be finished before the free space in the old Buffer is
+   // used up. The new Buffer must have space for all live strings plus
+   // the strings stored while moving
+   unsigned int newsize = Work * 3 + AllocateSpace1;
+   char * Buffer2 = new char [newsize + 1 + sizeof(LengthType) + MemPadding];
+   if (Buffer2 == 0) Error(3, newsize);// Allocation failed
+
+   // Make empty string at offset 0. This will be used for all empty strings
+   *(LengthType*)Buffer2 = 0;  Buffer2[sizeof(LengthType)] = 0;
+
+   // The old Buffer becomes MoveBuffer
+   MoveBuffer = Buffer;  MoveBufferSize = BufferSize;
+   MoveDataSize = DataSize;  MoveTop = Top;
+   MoveRate = Work / (Free + 1) + 1;
+   MoveNext = 0;
+
+   // Save new buffer
+   Buffer = Buffer2;  BufferSize = newsize + sizeof(LengthType) + 1;
+   DataSize = Top = sizeof(LengthType) + 1;  GarbageSize = 0;
+}
+
+
+// Move strings from MoveBuffer to Buffer until quota bytes have been moved.
+// Each index checked counts as the size of an offset
+void StringPoolL::Move(size_t quota) {
+   size_t Moved = 0;                   // Bytes moved so far
+   unsigned int Size;                  // Size of current string
+
+   while (MoveNext < Num && Moved < quota) {
+      if (Offsets[MoveNext]) {
+         Size = *(LengthType*)(MoveBuffer + Offsets[MoveNext]) + sizeof(LengthType) + 1;
+         if (DataSize + Size > BufferSize) {
+            // Buffer is full. Copy everything to a bigger Buffer.
+            // This finishes the move
+            ReserveBuf(DataSize + Size);
+            return;
+         }
+         memcpy_(Buffer + DataSize, MoveBuffer + Offsets[MoveNext], Size);
+         // Store new offset
+         Offsets[MoveNext] = Top = DataSize;
+         DataSize += Size;  Moved += Size;
+      }
+      Moved += sizeof(*Offsets);
+      MoveNext++;
+   }
+   if (MoveNext >= Num) {
+      // All strings have been moved. MoveBuffer is released by ReleaseOld
+      // after the current string has been stored
+      MoveNext = MoveIdle;
+   }
+}
+
+
+// Release OldBuffer, and MoveBuffer if all strings have been moved out of it.
+// Called after a new string has been stored, because the string may have
+// been copied from one of these buffers
+void StringPoolL::ReleaseOld() {
+   if (OldBuffer) {
+      delete[] OldBuffer;  OldBuffer = 0;
+   }
+   if (MoveBuffer && MoveNext == MoveIdle) {
+      delete[] MoveBuffer;  MoveBuffer = 0;
+   }
+}
+
+
+// Find string or insert it as a new string. Returns the index of the string
+int StringPoolL::Intern(PChar s) {
+   size_t len = 0;
+   if (s) len = strlen_(s);
+   return Intern(s, (unsigned int)len);
+}
+
+
+// Find string or insert it as a new string. Returns the index of the string
+int StringPoolL::Intern(PChar s, unsigned int len) {
+   // Check if too long
+   if (len > (LengthType)(-1)) {
+      Error(5,(int)len); // Longer than max LengthType
+   }
+   // Make hash table bigger when it is half full
+   if ((HashNum + 1) * 2 > HashSize) ReserveHash(HashNum + 1);
+
+   unsigned int hash = Hash(s, len);
+   unsigned int k = FindEntry(s, len, hash);
+   if (HashTable[k].Index) {
+      // Found
+      return HashTable[k].Index - 1;
+   }
+   // Not found. Store string at the first unused index
+   int i = Num;
+   Set(i, s, len);
+   // Insert in hash table
+   HashTable[k].Hash = hash;  HashTable[k].Index = i + 1;
+   HashNum++;
+   return i;
+}
+
+
+// Find interned string. Returns index or -1 if not found
+int StringPoolL::Find(PChar s) const {
+   size_t len = 0;
+   if (s) len = strlen_(s);
+   return Find(s, (unsigned int)len);
+}
+
+
+// Find interned string. Returns index or -1 if not found
+int StringPoolL::Find(PChar s, unsigned int len) const {
+   if (HashNum == 0) return -1;
+   // Index in an empty entry is 0, giving -1
+   return HashTable[FindEntry(s, len, Hash(s, len))].Index - 1;
+}
+
+
+// Allocate hash table for num interned strings
+void StringPoolL::ReserveHash(unsigned int num) {
+   unsigned int k, m;                  // Positions in old and new table
+
+   // New size is a power of 2 and at least twice the number of entries
+   unsigned int newsize = AllocateSpace3;
+   while (newsize < num * 2 || newsize < HashNum * 2) newsize *= 2;
+   // Only grow, not shrink:
+   if (newsize <= HashSize) return;
+
+   // Allocate new larger table
+   HashEntry * HashTable2 = new HashEntry [newsize];
+   if (HashTable2 == 0) Error(3, newsize); // Allocation failed
+   memset_(HashTable2, 0, newsize * sizeof(*HashTable2));
+
+   // Move entries to new table. The strings are not read because
+   // the hash values are stored in the table
+   for (k = 0; k < HashSize; k++) {
+      if (HashTable[k].Index) {
+         m = HashTable[k].Hash & (newsize - 1);
+         while (HashTable2[m].Index) m = (m + 1) & (newsize - 1);
+         HashTable2[m] = HashTable[k];
+      }
+   }
+
+   // Deallocate old table
+   if (HashTable) delete[] HashTable;
+
+   // Save new table
+   HashTable = HashTable2;  HashSize = newsize;
+}
+
+
+// Search for string in HashTable. Returns the position of the entry 
+// containing the string, or the empty entry where it should be inserted
+unsigned int StringPoolL::FindEntry(PChar s, unsigned int len, unsigned int hash) const {
+   unsigned int k = hash & (HashSize - 1);
+   while (HashTable[k].Index) {
+      if (HashTable[k].Hash == hash) {
+         // Compare lengths before comparing strings
+         int i = HashTable[k].Index - 1;
+         if (Len(i) == len && memcmp(Get(i), s, len) == 0) return k;
+      }
+      // Try next entry
+      k = (k + 1) & (HashSize - 1);
+   }
+   return k;
+}
+
+
+// Hash function for Intern and Find. Reads 8 bytes at a time
+unsigned int StringPoolL::Hash(PChar s, unsigned int len) {
+   const unsigned long long Multiplier = 0x9E3779B97F4A7C15ULL;
+   unsigned long long h = len;         // Hash value
+   unsigned long long w;               // 8 bytes of string
+   unsigned int i;                     // Position in string
+   for (i = 0; i + 8 <= len; i += 8) {
+      memcpy_(&w, s + i, 8);
+      h = (h ^ w) * Multiplier;
+      h ^= h >> 32;
+   }
+   // Remaining 0 - 7 bytes
+   w = 0;
+   memcpy_(&w, s + i, len - i);
+   h = (h ^ w) * Multiplier;
+   h ^= h >> 32;
+   // The high bits are mixed best
+   return (unsigned int)((h * Multiplier) >> 32);
+}
+
+
 // Format string using printf style formatting
 StringPoolL::StringElement const & StringPoolL::StringElement::Printf(const char * format, ...) {
    // Temporary buffer for new string. 
@@ -574,11 +903,102 @@ int StringPoolL::StringElement::Write(FILE * f) {
 }
 
 
+#if defined(SIMD_SEARCH) && defined(__AVX2__)
+
+// Index of lowest set bit. x must be nonzero
+static inline int StringPoolLBitScan(unsigned int x) {
+#ifdef _MSC_VER
+   unsigned long i;
+   _BitScanForward(&i, x);
+   return (int)i;
+#else
+   return __builtin_ctz(x);
+#endif
+}
+
+// Search for substring n of length nlen in string h of length hlen.
+// Returns the position of the substring, or -1 if not found.
+// The first and the last character of n are compared with 32 positions of
+// h at a time. The whole substring is compared only at the positions where
+// both match. The last block overlaps the previous block, so that nothing
+// is read beyond the end of h
+static int StringPoolLSearch(PChar h, unsigned int hlen, PChar n, unsigned int nlen) {
+   unsigned int i = 0;                 // Position in h
+   if (nlen == 0) return 0;            // Empty substring is found at position 0
+   if (nlen > hlen) return -1;         // Substring longer than string
+   __m256i first = _mm256_set1_epi8(n[0]);
+   __m256i last  = _mm256_set1_epi8(n[nlen-1]);
+   unsigned int end = hlen - nlen + 1; // Number of possible positions
+   if (end >= 32) {
+      unsigned int ignore = 0;         // Mask for positions already checked
+      for (;;) {
+         __m256i f = _mm256_cmpeq_epi8(first, _mm256_loadu_si256((__m256i const *)(h + i)));
+         __m256i l = _mm256_cmpeq_epi8(last,  _mm256_loadu_si256((__m256i const *)(h + i + nlen - 1)));
+         unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(f, l)) & ~ignore;
+         while (mask) {
+            int j = StringPoolLBitScan(mask);
+            if (memcmp(h + i + j, n, nlen) == 0) return i + j;
+            mask &= mask - 1;          // Clear lowest bit
+         }
+         if (i + 32 >= end) return -1;
+         i += 32;
+         if (i + 32 > end) {
+            // The last block overlaps the previous block
+            ignore = (1u << (i - (end - 32))) - 1;
+            i = end - 32;
+         }
+      }
+   }
+   // String too short for a whole block
+   for (; i < end; i++) {
+      if (h[i] == n[0] && memcmp(h + i, n, nlen) == 0) return i;
+   }
+   return -1;
+}
+
+#elif defined(SIMD_SEARCH)
+
+// Search for substring n of length nlen in string h of length hlen.
+// Returns the position of the substring, or -1 if not found.
+// The pcmpestri instruction finds the first position in a 16-byte block of
+// h where the first 16 characters of n match, including a partial match at
+// the end of the block. The whole substring is compared at this position.
+// This reads up to 15 bytes beyond the end of h. StringPoolL has MemPadding
+// bytes extra at the end of Buffer for this purpose
+static int StringPoolLSearch(PChar h, unsigned int hlen, PChar n, unsigned int nlen) {
+   unsigned int i = 0;                 // Position in h
+   int j;                              // Position in block
+   char nbuf[16] = {0};                // First 16 characters of n
+   if (nlen == 0) return 0;            // Empty substring is found at position 0
+   int nl = nlen < 16 ? (int)nlen : 16;
+   memcpy_(nbuf, n, nl);
+   __m128i nv = _mm_loadu_si128((__m128i const *)nbuf);
+   while (i + nlen <= hlen) {
+      int hl = hlen - i < 16 ? (int)(hlen - i) : 16;
+      j = _mm_cmpestri(nv, nl, _mm_loadu_si128((__m128i const *)(h + i)), hl, 
+         _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED);
+      if (j == 16) {
+         i += 16;  continue;           // No match in this block
+      }
+      if (i + j + nlen > hlen) break;  // Not room for n
+      if (memcmp(h + i + j, n, nlen) == 0) return i + j;
+      i += j + 1;                      // Continue after this position
+   }
+   return -1;
+}
+
+#endif
+
+
 // Search in string for any substring.
 // The return value is the position of the substring if found,
 // or -1 if not found.
 int StringPoolL::StringElement::SearchForSubstring(PChar s) {
    PChar h = arr.Get(index);
+#ifdef SIMD_SEARCH
+   // Use the stored length of the string
+   return StringPoolLSearch(h, Len(), s, (unsigned int)strlen_(s));
+#else
    PChar n = strstr_(h, s);
    if (n) {
       // Substring found. Return offset
@@ -586,11 +1006,12 @@ int StringPoolL::StringElement::SearchForSubstring(PChar s) {
    }
    // Not found
    return -1;
+#endif
 }
 
 
 // Set string to a part of another string
-StringPoolL::StringElement const & StringPoolL::StringElement::SetToSubstring(PChar s, unsigned int start, unsigned int len) {
+StringPoolL::StringElement const & StringPoolL::StringElement::SetToSubstring(PChar s, size_t start, size_t len) {
    // Get length of full string s
    size_t len1 = 0; 
    if (s) len1 = strlen_(s);
@@ -599,7 +1020,7 @@ StringPoolL::StringElement const & StringPoolL::StringElement::SetToSubstring(PC
       arr.Error(2, start + len);
    }
    // Save substring
-   arr.Set(index, s + start, len);
+   arr.Set(index, s + start, (unsigned int)len);
    return *this;
 }
 
@@ -623,6 +1044,146 @@ char & StringPoolL::StringElement::operator[] (int i) {
 // To run this example, just compile this file for console mode and run it.
 // You may play with this example as you like
 
+// Latency benchmark. Stores random strings at random indices and counts the
+// time of each Set or Concatenate in a histogram. Bin k counts operations
+// that take less than 2^k * 0.125 microseconds
+const int LatencyBins = 24;
+
+typedef std::chrono::steady_clock Clock;
+
+// Returns total time in seconds
+double LatencyHistogram(long long * histogram, bool incremental) {
+   const int NumStrings = 1000000;     // Number of string indices used
+   const int NumOperations = 5000000;  // Number of Set and Concatenate
+   char text[256];                     // Random text
+   unsigned int r = 1;                 // Random number
+   int i, k;
+
+   for (k = 0; k < 255; k++) {
+      r = r * 1103515245 + 12345;  text[k] = 'a' + (r >> 16) % 26;
+   }
+   text[255] = 0;
+   for (k = 0; k < LatencyBins; k++) histogram[k] = 0;
+
+   StringPoolL strings;
+   if (incremental) strings.SetIncremental();
+   Clock::time_point start0 = Clock::now();
+   for (int n = 0; n < NumOperations; n++) {
+      r = r * 1103515245 + 12345;
+      i = (r >> 4) % NumStrings;
+      Clock::time_point start = Clock::now();
+      if ((r & 3) == 0 && i < strings.GetNum()) {
+         strings[i] += text + 240;     // Concatenate 15 characters
+      }
+      else {
+         strings.Set(i, text + (r >> 25), 8 + (r >> 24) % 120);
+      }
+      double t = std::chrono::duration<double>(Clock::now() - start).count();
+      // Find bin
+      for (k = 0; k < LatencyBins - 1 && t >= 0.125E-6 * (1 << k); k++) {}
+      histogram[k]++;
+   }
+   return std::chrono::duration<double>(Clock::now() - start0).count();
+}
+
+// Interning benchmark. Interns tokens with a skewed distribution, like words
+// in log files, and compares with a linear search through all strings
+void InternBenchmark() {
+   const int NumTokens = 5000000;      // Number of tokens to intern
+   const int NumLinear = 20000;        // Number of tokens to intern with linear search
+   const int Vocabulary = 1 << 20;     // Number of different tokens
+   const int TokenSize = 16;           // Maximum length of token + 1
+   char * tokens = new char[Vocabulary * TokenSize]; // List of different tokens
+   unsigned long long r = 1;           // Random number
+   int i, n, v;
+   unsigned int len;
+
+   // Make tokens
+   for (v = 0; v < Vocabulary; v++) {
+      sprintf(tokens + v * TokenSize, "tok%x", v * 2654435761u);
+   }
+
+   StringPoolL strings;
+   Clock::time_point start = Clock::now();
+   for (n = 0; n < NumTokens; n++) {
+      // Random token number with probability proportional to 1/v
+      r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+      v = (int)((r >> 20) & ((1u << (r >> 59) % 21) - 1));
+      len = (unsigned int)strlen(tokens + v * TokenSize);
+      strings.Intern(tokens + v * TokenSize, len);
+   }
+   double time1 = std::chrono::duration<double>(Clock::now() - start).count();
+   printf("\n\nIntern %i tokens, %i different: %6.1f ns per token", 
+      NumTokens, strings.GetNum(), time1 * 1E9 / NumTokens);
+
+   StringPoolL strings2;
+   r = 1;
+   start = Clock::now();
+   for (n = 0; n < NumLinear; n++) {
+      r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+      v = (int)((r >> 20) & ((1u << (r >> 59) % 21) - 1));
+      len = (unsigned int)strlen(tokens + v * TokenSize);
+      // Search all strings
+      for (i = 0; i < strings2.GetNum(); i++) {
+         if (strings2[i].Len() == len && memcmp(strings2[i], tokens + v * TokenSize, len) == 0) break;
+      }
+      if (i == strings2.GetNum()) strings2.Set(i, tokens + v * TokenSize, len);
+   }
+   double time2 = std::chrono::duration<double>(Clock::now() - start).count();
+   printf("\nLinear search, %i tokens, %i different: %6.1f ns per token\n", 
+      NumLinear, strings2.GetNum(), time2 * 1E9 / NumLinear);
+   delete[] tokens;
+}
+
+// Substring search benchmark. Searches a corpus of log lines for some
+// substrings with SearchForSubstring and with strstr. Compile with
+// -DUSE_SIMD_SEARCH to compare the built-in SIMD search with strstr.
+void SearchBenchmark() {
+   const int NumLines = 100000;        // Number of log lines
+   const int Repeat = 10;              // Number of times to search all lines
+   static const char * Levels[] = {"INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+   static const char * Paths[] = {"/api/v1/items", "/api/v1/users", "/static/app.js", "/health", "/api/v2/orders"};
+   static const char * Patterns[] = {"ERROR", "status=503", "/api/v2/orders", "user_agent=curl", "timeout"};
+   const int NumPatterns = sizeof(Patterns) / sizeof(*Patterns);
+   unsigned int r = 1;                 // Random number
+   int i, k, m;
+   StringPoolL lines;
+
+   // Make log lines
+   for (i = 0; i < NumLines; i++) {
+      r = r * 1103515245 + 12345;
+      lines[i].Printf("2026-10-19T%02u:%02u:%02u.%03uZ %-5s [worker-%u] GET %s status=%u bytes=%u "
+         "latency_ms=%u client=10.%u.%u.%u user_agent=Mozilla/5.0 request_id=%08x",
+         i / 3600 % 24, i / 60 % 60, i % 60, r % 1000, Levels[(r >> 8) % 6], (r >> 11) % 16,
+         Paths[(r >> 15) % 5], (r >> 18) % 50 ? 200 : 503, (r >> 4) % 100000, (r >> 20) % 500,
+         r >> 24, (r >> 16) & 255, (r >> 8) & 255, r * 2654435761u);
+   }
+
+   printf("\n\nSearch in %i log lines, ns per line:", NumLines);
+   printf("\n%-20s %8s %8s %8s", "substring", "found", "Search", "strstr");
+   for (k = 0; k < NumPatterns; k++) {
+      int found1 = 0, found2 = 0;
+      Clock::time_point start = Clock::now();
+      for (m = 0; m < Repeat; m++) {
+         for (i = 0; i < NumLines; i++) {
+            found1 += lines[i].SearchForSubstring(Patterns[k]) >= 0;
+         }
+      }
+      double time1 = std::chrono::duration<double>(Clock::now() - start).count();
+      start = Clock::now();
+      for (m = 0; m < Repeat; m++) {
+         for (i = 0; i < NumLines; i++) {
+            found2 += strstr(lines[i], Patterns[k]) != 0;
+         }
+      }
+      double time2 = std::chrono::duration<double>(Clock::now() - start).count();
+      if (found1 != found2) printf("\nError: different results");
+      printf("\n%-20s %8i %8.1f %8.1f", Patterns[k], found1 / Repeat,
+         time1 * 1E9 / NumLines / Repeat, time2 * 1E9 / NumLines / Repeat);
+   }
+   printf("\n");
+}
+
 int main() {
    int i, j, n;                        // Indices
 
@@ -681,6 +1242,14 @@ int main() {
    strings[7].SetToSubstring(strings[4], j, 5);
    // This will extract "Molly" from "Hello Molly" and store it in strings[7]
 
+   // Intern stores a string only if it is not already stored by Intern.
+   // It returns the index of the string:
+   i = strings.Intern("Goodbye");      // Stored as new string number 8
+   j = strings.Intern("Goodbye");      // Found. Gives the same index, j = 8
+   // strings[6] is not found because it was not stored by Intern.
+   // Find tells if an interned string exists without storing it:
+   if (strings.Find("Hello") < 0) printf("\"Hello\" has not been interned\n");
+
    // To loop through all strings, we start at 0 and end at GetNum()-1:
    for (i = 0; i < strings.GetNum(); i++) {
 
@@ -703,5 +1272,24 @@ int main() {
    // causes a re-allocation of memory. A string should always be 
    // identified by its number, not by a pointer.
 
+   // Benchmark of latency with and without incremental garbage collection
+   long long hist1[LatencyBins], hist2[LatencyBins];
+   double time1 = LatencyHistogram(hist1, false);
+   double time2 = LatencyHistogram(hist2, true);
+   printf("\n\nLatency of Set and Concatenate:");
+   printf("\n  time below   stop-the-world  incremental");
+   for (i = 0; i < LatencyBins; i++) {
+      if (hist1[i] || hist2[i]) {
+         printf("\n%10.3f us %14lli %12lli", 0.125 * (1 << i), hist1[i], hist2[i]);
+      }
+   }
+   printf("\n total time %13.3f s %10.3f s\n", time1, time2);
+
+   // Benchmark of SearchForSubstring
+   SearchBenchmark();
+
+   // Benchmark of Intern
+   InternBenchmark();
+
    return 0;
 }
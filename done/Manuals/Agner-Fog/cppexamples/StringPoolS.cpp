@@ -1,14 +1,14 @@
 /*************************  StringPoolS.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2008-06-12
-* Last modified: 2011-07-29
+* Last modified: 2026-10-19
 * Description:
 * Defines memory pool for storing ASCII strings or UTF-8 encoded strings of
 * arbitrary length.
 *
 * The latest version of this file is available at:
 * www.agner.org/optimize/cppexamples.zip
-* (c) 2008-2011 GNU General Public License www.gnu.org/copyleft/gpl.html
+* (c) 2008-2026 GNU General Public License www.gnu.org/copyleft/gpl.html
 *******************************************************************************
 *
 * This string pool is a useful replacement for string classes such as 'string' 
@@ -33,6 +33,11 @@
 * StringPoolS may optionally use the function library asmlib for fast string 
 * handling, especially fast string searching. Define USE_ASMLIB to use this.
 * The asmlib library is available at (www.agner.org/optimize/asmlib.zip) 
+* Without asmlib, SearchForSubstring uses strstr from the standard library.
+* Define USE_SIMD_SEARCH to use a built-in search with AVX2 or SSE4.2
+* instructions instead, if these are enabled in the compiler options (e.g.
+* -mavx2 or /arch:AVX2). It is faster than a simple strstr, but slower than
+* the vectorized strstr in newer versions of glibc.
 *
 * Each string is identified by an integer index. For example:
 * StringPoolS strings;
@@ -57,6 +62,12 @@
 * more than the double size and move all strings to the new block. Garbage
 * collection takes place only when a new memory block is allocated.
 *
+* Moving all strings at once can take a long time when the pool is big. Call
+* SetIncremental to avoid such pauses. In incremental mode, a new memory
+* block is allocated already when the old block is 3/4 full, and the strings
+* are moved to the new block a few at a time during the following calls to
+* Set and Concatenate. See StringPoolL.cpp for details.
+*
 * Note that you should never store a pointer to a string in the string pool
 * because the pointer will become invalid in case the assignment or
 * modification of another string causes the memory to be re-allocated.
@@ -90,6 +101,7 @@
 #include <stdlib.h>               // For exit in Error function
 #include <stdarg.h>               // For va_list, va_start
 #include <stdio.h>                // Needed for example only
+#include <chrono>                 // Needed for example only
 //#include <varargs.h>            // Include varargs.h for va_list, va_start only if required by your system
 
 #ifdef   USE_ASMLIB
@@ -106,8 +118,16 @@
 #define  strlen_  strlen
 #define  strcmp_  strcmp
 #define  strstr_  strstr
+#if defined(USE_SIMD_SEARCH) && (defined(__AVX2__) || defined(__SSE4_2__))
+#define  SIMD_SEARCH              // Use built-in SIMD substring search
+#include <immintrin.h>            // For SIMD substring search
+#endif
+#if defined(SIMD_SEARCH) && !defined(__AVX2__)
+#define  MEM_PADDING 15           // SSE4.2 search reads up to 15 bytes beyond a string
+#else
 #define  MEM_PADDING 0
 #endif
+#endif
 
 // Define pointer to zero-terminated string
 typedef char const * PChar;
@@ -158,13 +178,15 @@ public:
    void Concatenate(int i, PChar s);   // Concatenate strings. Used by StringElement 
    void ReserveBuf(int newsize);       // Allocate memory for string space
    void ReserveNum(int newsize);       // Allocate memory for string indices
+   void SetIncremental(int minsize = 1 << 20); // Incremental garbage collection when Buffer is bigger than minsize. 0 = off
 
    // Define desired allocation sizes. You may change these values:
    enum DefineSizes {
       AllocateSpace1 = 4096,           // Minimum number of characters to allocate in string buffer 
       AllocateSpace2 = 1024,           // Minimum number of indices to allocate in offsets buffer
       FormatLength   = 1023,           // Maximum length of strings written with Printf
-      MemPadding     = MEM_PADDING     // Memory buffer padding
+      MemPadding     = MEM_PADDING,    // Memory buffer padding
+      MoveQuantum    = 256             // Minimum number of bytes moved per operation in incremental mode
    };
 protected:
    char * Get(int i) const;            // Read string. Used only from StringElement 
@@ -179,6 +201,21 @@ private:
    int GarbageSize;                    // Total size of garbage in Buffer
    int Top;                            // Highest used Offset
    int Num;                            // Number of strings = highest used index in Offsets + 1
+   // Incremental garbage collection:
+   char * MoveBuffer;                  // Old Buffer while strings are moved from it
+   int MoveBufferSize;                 // Size of MoveBuffer
+   int MoveDataSize;                   // Used part of MoveBuffer
+   int MoveTop;                        // Highest used Offset in MoveBuffer
+   int MoveRate;                       // Bytes to move per byte stored
+   int IncrementalMin;                 // Minimum BufferSize for incremental garbage collection. 0 = off
+   int MoveNext;                       // Strings below this index are in Buffer, the rest in MoveBuffer
+   enum {MoveIdle = 0x7FFFFFFF};       // Value of MoveNext when no strings are being moved
+   char * Base(int i) const {          // Buffer containing string i
+      return i < MoveNext ? Buffer : MoveBuffer;}
+   void Collect(int len);              // Incremental garbage collection before storing len characters
+   void StartMove();                   // Start moving strings to a new Buffer
+   void Move(size_t quota);            // Move strings from MoveBuffer to Buffer
+   void ReleaseOld();                  // Release OldBuffer and MoveBuffer when no longer needed
    char * Allocate(int i, int len);    // Make space for a new string
    StringPoolS(StringPoolS &){};       // Private copy constructor to prevent copying
    void operator = (StringPoolS &){};  // Private operator = to prevent copying
@@ -214,6 +251,7 @@ inline bool operator  > (StringPoolS::StringElement const & a, StringPoolS::Stri
 StringPoolS::StringPoolS() {
    // Set everything to zero
    memset_(this, 0, sizeof(*this));
+   MoveNext = MoveIdle;
 }
 
 
@@ -222,6 +260,7 @@ StringPoolS::~StringPoolS() {
    // Free allocated memory
    if (Buffer)    delete[] Buffer;
    if (OldBuffer) delete[] OldBuffer;
+   if (MoveBuffer) delete[] MoveBuffer;
    if (Offsets)   delete[] Offsets;
    // Set everything to zero
    memset_(this, 0, sizeof(*this));
@@ -232,8 +271,15 @@ StringPoolS::~StringPoolS() {
 void StringPoolS::Clear() {
    // Set all offsets to zero
    if (Offsets) memset_(Offsets, 0, Num * sizeof(*Offsets));
-   // Indicate that Buffer is empty, but do not deallocate
+   // Stop moving strings
+   if (MoveBuffer) {
+      delete[] MoveBuffer;  MoveBuffer = 0;
+   }
+   MoveNext = MoveIdle;
+   // Indicate that Buffer is empty, but do not deallocate.
+   // Keep the empty string at offset 0
    DataSize = GarbageSize = 0;
+   if (Buffer) DataSize = Top = 1;
 }
 
 
@@ -254,19 +300,20 @@ void StringPoolS::Set(int i, PChar s) {
    if (Len == 0) {
       // Erase string
       if (Offsets[i]) {
-         GarbageSize += strlen_(Buffer + Offsets[i]) + 1;
+         // Garbage in MoveBuffer is not counted
+         if (i < MoveNext) GarbageSize += strlen_(Buffer + Offsets[i]) + 1;
          Offsets[i] = 0;
       }
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(Len);
    // Make space for string
    char * p = Allocate(i, Len);
    // Insert string
    memcpy_(p, s, Len+1);
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -285,11 +332,14 @@ void StringPoolS::Set(int i, PChar s, int Len) {
    if (Len <= 0) {
       // Erase string
       if (Offsets[i]) {
-         GarbageSize += strlen_(Buffer + Offsets[i]) + 1;
+         // Garbage in MoveBuffer is not counted
+         if (i < MoveNext) GarbageSize += strlen_(Buffer + Offsets[i]) + 1;
          Offsets[i] = 0;
       }
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(Len);
    // Make space for string
    char * p = Allocate(i, Len);
    // Insert string
@@ -297,9 +347,7 @@ void StringPoolS::Set(int i, PChar s, int Len) {
    // Zero-terminate
    p[Len] = 0;
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -318,19 +366,19 @@ void StringPoolS::Concatenate(int i, PChar s) {
       Set(i, s);
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(len2);
    // Length of first string
-   len1 = strlen_(Buffer + Offsets[i]);
+   len1 = strlen_(Get(i));
    // Remember position of string1
-   PChar string1 = Buffer + Offsets[i];
+   PChar string1 = Get(i);
    // Make space for combined string
    char * p = Allocate(i, len1 + len2);
    // Copy strings
    memcpy_(p, string1, len1);
    memcpy_(p + len1, s, len2 + 1);
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -339,10 +387,14 @@ void StringPoolS::ReserveBuf(int newsize) {
    int i;                              // Loop counter
    int DataSize2 = 0;                  // Used part of buffer after garbage collection
    int Strlen;                         // Length of current string
+   int Live = DataSize - GarbageSize;  // Size of strings to copy, at most
+
+   // Strings that have not been moved yet are copied from MoveBuffer
+   if (MoveNext != MoveIdle) Live += MoveDataSize;
 
    // Decide new size
-   if (newsize < (DataSize - GarbageSize) * 2 + AllocateSpace1) {
-       newsize = (DataSize - GarbageSize) * 2 + AllocateSpace1;
+   if (newsize < Live * 2 + AllocateSpace1) {
+       newsize = Live * 2 + AllocateSpace1;
    }
    // Allocate new larger block
    char * Buffer2 = new char [newsize + 1 + MemPadding];
@@ -357,10 +409,10 @@ void StringPoolS::ReserveBuf(int newsize) {
       for (i = 0; i < Num; i++) {
          if (Offsets[i]) {
             // Length of string
-            Strlen = strlen_(Buffer + Offsets[i]);
+            Strlen = strlen_(Base(i) + Offsets[i]);
             if (Strlen) {
                // String is not empty, copy it
-               memcpy_ (Buffer2 + DataSize2, Buffer + Offsets[i], Strlen + 1);
+               memcpy_ (Buffer2 + DataSize2, Base(i) + Offsets[i], Strlen + 1);
                // Store new offset
                Offsets[i] = Top = DataSize2;
                // Offset to next
@@ -380,6 +432,10 @@ void StringPoolS::ReserveBuf(int newsize) {
       // contain a string being copied. Remember to delete Oldbuffer
       // after new string has been stored
       OldBuffer = Buffer;
+
+      // All strings have been moved out of MoveBuffer. It is released
+      // together with OldBuffer
+      MoveNext = MoveIdle;
    }
 
    // Save new buffer
@@ -429,7 +485,7 @@ char * StringPoolS::Get(int i) const {
       Error(1, i);      
    }
    // Return pointer
-   return Buffer + Offsets[i];
+   return Base(i) + Offsets[i];
 }
 
 
@@ -465,14 +521,32 @@ char * StringPoolS::Allocate(int i, int len) {
    // This is allready done by Set or Concatenate before calling Allocate:
    // if (i >= OffsetsSize) ReserveNum(i+1); 
 
+   if (i >= MoveNext) {
+      // String i has not been moved yet. Keep it in MoveBuffer
+      if (Offsets[i] && (int)Offsets[i] == MoveTop && MoveTop + len + 1 <= MoveBufferSize) {
+         // This is last in MoveBuffer. Can grow without overwriting other strings
+         MoveDataSize = MoveTop + len + 1;
+         return MoveBuffer + MoveTop;
+      }
+      if (Offsets[i] && (int)strlen_(MoveBuffer + Offsets[i]) >= len) {
+         // New string fits into same space
+         return MoveBuffer + Offsets[i];
+      }
+      if (MoveDataSize + len + 1 <= MoveBufferSize) {
+         // Put new string at end of MoveBuffer
+         Offsets[i] = MoveTop = MoveDataSize;
+         MoveDataSize += len + 1;
+         return MoveBuffer + MoveTop;
+      }
+      // MoveBuffer is full. This can only happen if strings are moved
+      // slower than expected. Move the rest now and continue below
+      Move((size_t)(-1));
+   }
+
    if (Offsets[i]) {
       // Index i allready has a string
-      if (Offsets[i] == Top) {
+      if (Offsets[i] == Top && Top + len + 1 <= BufferSize) {
          // This is last in Buffer. Can grow without overwriting other strings
-         if (Top + len + 1 > BufferSize) {
-            // Buffer not big enough
-            ReserveBuf(Top + len + 1);
-         }
          // Reserve size
          DataSize = Top + len + 1;
          // Return pointer. Offsets[i] unchanged
@@ -502,6 +576,103 @@ char * StringPoolS::Allocate(int i, int len) {
 }
 
 
+// Turn on incremental garbage collection for Buffer sizes bigger than minsize.
+// minsize = 0 turns it off
+void StringPoolS::SetIncremental(int minsize) {
+   // Finish any current move before turning off
+   if (minsize == 0 && MoveNext != MoveIdle) {
+      Move((size_t)(-1));  ReleaseOld();
+   }
+   IncrementalMin = minsize;
+}
+
+
+// Incremental garbage collection. Called by Set and Concatenate before
+// storing a string of length len
+void StringPoolS::Collect(int len) {
+   if (MoveNext == MoveIdle) {
+      // Start moving strings when Buffer is 3/4 full
+      if (BufferSize < IncrementalMin || DataSize < BufferSize - BufferSize / 4 || MoveBuffer) return;
+      StartMove();
+   }
+   // Move strings in proportion to the size of the new string
+   Move((size_t)MoveRate * (len + 1) + MoveQuantum);
+}
+
+
+// Allocate a new Buffer and start moving strings to it.
+// See StringPoolL::StartMove for an explanation of the sizes
+void StringPoolS::StartMove() {
+   // Work to do is the size of live strings plus the size of the indices
+   // that must be checked
+   int Work = DataSize - GarbageSize + Num * (int)sizeof(*Offsets);
+   // Free space in old Buffer
+   int Free = BufferSize - DataSize;
+
+   // New Buffer
+   int newsize = Work * 3 + AllocateSpace1;
+   char * Buffer2 = new char [newsize + 1 + MemPadding];
+   if (Buffer2 == 0) Error(3, newsize + 1);// Allocation failed
+
+   // Make empty string at offset 0. This will be used for all empty strings
+   Buffer2[0] = 0;
+
+   // The old Buffer becomes MoveBuffer
+   MoveBuffer = Buffer;  MoveBufferSize = BufferSize;
+   MoveDataSize = DataSize;  MoveTop = Top;
+   MoveRate = Work / (Free + 1) + 1;
+   MoveNext = 0;
+
+   // Save new buffer
+   Buffer = Buffer2;  BufferSize = newsize + 1;
+   DataSize = Top = 1;  GarbageSize = 0;
+}
+
+
+// Move strings from MoveBuffer to Buffer until quota bytes have been moved.
+// Each index checked counts as the size of an offset
+void StringPoolS::Move(size_t quota) {
+   size_t Moved = 0;                   // Bytes moved so far
+   int Size;                           // Size of current string
+
+   while (MoveNext < Num && Moved < quota) {
+      if (Offsets[MoveNext]) {
+         Size = (int)strlen_(MoveBuffer + Offsets[MoveNext]) + 1;
+         if (DataSize + Size > BufferSize) {
+            // Buffer is full. Copy everything to a bigger Buffer.
+            // This finishes the move
+            ReserveBuf(DataSize + Size);
+            return;
+         }
+         memcpy_(Buffer + DataSize, MoveBuffer + Offsets[MoveNext], Size);
+         // Store new offset
+         Offsets[MoveNext] = Top = DataSize;
+         DataSize += Size;  Moved += Size;
+      }
+      Moved += sizeof(*Offsets);
+      MoveNext++;
+   }
+   if (MoveNext >= Num) {
+      // All strings have been moved. MoveBuffer is released by ReleaseOld
+      // after the current string has been stored
+      MoveNext = MoveIdle;
+   }
+}
+
+
+// Release OldBuffer, and MoveBuffer if all strings have been moved out of it.
+// Called after a new string has been stored, because the string may have
+// been copied from one of these buffers
+void StringPoolS::ReleaseOld() {
+   if (OldBuffer) {
+      delete[] OldBuffer;  OldBuffer = 0;
+   }
+   if (MoveBuffer && MoveNext == MoveIdle) {
+      delete[] MoveBuffer;  MoveBuffer = 0;
+   }
+}
+
+
 // Format string using printf style formatting
 StringPoolS::StringElement const & StringPoolS::StringElement::Printf(const char * format, ...) {
    // Temporary buffer for new string. 
@@ -528,11 +699,106 @@ int StringPoolS::StringElement::Write(FILE * f) {
 }
 
 
+#if defined(SIMD_SEARCH) && defined(__AVX2__)
+
+// Index of lowest set bit. x must be nonzero
+static inline int StringPoolSBitScan(unsigned int x) {
+#ifdef _MSC_VER
+   unsigned long i;
+   _BitScanForward(&i, x);
+   return (int)i;
+#else
+   return __builtin_ctz(x);
+#endif
+}
+
+// Search for substring n in string h.
+// Returns the position of the substring, or -1 if not found.
+// The first and the last character of n are compared with 32 positions of
+// h at a time. The whole substring is compared only at the positions where
+// both match. See StringPoolL.cpp for a version that uses stored lengths
+static int StringPoolSSearch(PChar h, PChar n) {
+   int hlen = (int)strlen_(h);         // Length of h
+   int nlen = (int)strlen_(n);         // Length of n
+   int i = 0;                          // Position in h
+   if (nlen == 0) return 0;            // Empty substring is found at position 0
+   if (nlen > hlen) return -1;         // Substring longer than string
+   __m256i first = _mm256_set1_epi8(n[0]);
+   __m256i last  = _mm256_set1_epi8(n[nlen-1]);
+   int end = hlen - nlen + 1;          // Number of possible positions
+   if (end >= 32) {
+      unsigned int ignore = 0;         // Mask for positions already checked
+      for (;;) {
+         __m256i f = _mm256_cmpeq_epi8(first, _mm256_loadu_si256((__m256i const *)(h + i)));
+         __m256i l = _mm256_cmpeq_epi8(last,  _mm256_loadu_si256((__m256i const *)(h + i + nlen - 1)));
+         unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(f, l)) & ~ignore;
+         while (mask) {
+            int j = StringPoolSBitScan(mask);
+            if (memcmp(h + i + j, n, nlen) == 0) return i + j;
+            mask &= mask - 1;          // Clear lowest bit
+         }
+         if (i + 32 >= end) return -1;
+         i += 32;
+         if (i + 32 > end) {
+            // The last block overlaps the previous block
+            ignore = (1u << (i - (end - 32))) - 1;
+            i = end - 32;
+         }
+      }
+   }
+   // String too short for a whole block
+   for (; i < end; i++) {
+      if (h[i] == n[0] && memcmp(h + i, n, nlen) == 0) return i;
+   }
+   return -1;
+}
+
+#elif defined(SIMD_SEARCH)
+
+// Search for substring n in string h.
+// Returns the position of the substring, or -1 if not found.
+// The pcmpistri instruction finds the first position in a 16-byte block of
+// h where the first 16 characters of n match, including a partial match at
+// the end of the block. The whole substring is compared at this position.
+// This reads up to 15 bytes beyond the end of h. StringPoolS has MemPadding
+// bytes extra at the end of Buffer for this purpose
+static int StringPoolSSearch(PChar h, PChar n) {
+   const int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED;
+   int nlen = (int)strlen_(n);         // Length of n
+   int i = 0;                          // Position in h
+   int j;                              // Position in block
+   char nbuf[16] = {0};                // First 16 characters of n
+   if (nlen == 0) return 0;            // Empty substring is found at position 0
+   memcpy_(nbuf, n, nlen < 16 ? nlen : 16);
+   __m128i nv = _mm_loadu_si128((__m128i const *)nbuf);
+   for (;;) {
+      __m128i hv = _mm_loadu_si128((__m128i const *)(h + i));
+      j = _mm_cmpistri(nv, hv, mode);
+      if (j < 16) {
+         // Possible match
+         if (strncmp(h + i + j, n, nlen) == 0) return i + j;
+         i += j + 1;                   // Continue after this position
+      }
+      else if (_mm_cmpistrz(nv, hv, mode)) {
+         return -1;                    // End of h
+      }
+      else {
+         i += 16;                      // Next block
+      }
+   }
+}
+
+#endif
+
+
 // Search in string for any substring.
 // The return value is the position of the substring if found,
 // or -1 if not found.
 int StringPoolS::StringElement::SearchForSubstring(PChar s) {
    PChar h = arr.Get(index);
+#ifdef SIMD_SEARCH
+   return StringPoolSSearch(h, s);
+#else
    PChar n = strstr_(h, s);
    if (n) {
       // Substring found. Return offset
@@ -540,6 +806,7 @@ int StringPoolS::StringElement::SearchForSubstring(PChar s) {
    }
    // Not found
    return -1;
+#endif
 }
 
 
@@ -577,6 +844,97 @@ char & StringPoolS::StringElement::operator[] (int i) {
 // To run this example, just compile this file for console mode and run it.
 // You may play with this example as you like
 
+// Latency benchmark. Stores random strings at random indices and counts the
+// time of each Set or Concatenate in a histogram. Bin k counts operations
+// that take less than 2^k * 0.125 microseconds
+const int LatencyBins = 24;
+
+typedef std::chrono::steady_clock Clock;
+
+// Returns total time in seconds
+double LatencyHistogram(long long * histogram, bool incremental) {
+   const int NumStrings = 1000000;     // Number of string indices used
+   const int NumOperations = 5000000;  // Number of Set and Concatenate
+   char text[256];                     // Random text
+   unsigned int r = 1;                 // Random number
+   int i, k;
+
+   for (k = 0; k < 255; k++) {
+      r = r * 1103515245 + 12345;  text[k] = 'a' + (r >> 16) % 26;
+   }
+   text[255] = 0;
+   for (k = 0; k < LatencyBins; k++) histogram[k] = 0;
+
+   StringPoolS strings;
+   if (incremental) strings.SetIncremental();
+   Clock::time_point start0 = Clock::now();
+   for (int n = 0; n < NumOperations; n++) {
+      r = r * 1103515245 + 12345;
+      i = (r >> 4) % NumStrings;
+      Clock::time_point start = Clock::now();
+      if ((r & 3) == 0 && i < strings.GetNum()) {
+         strings[i] += text + 240;     // Concatenate 15 characters
+      }
+      else {
+         strings.Set(i, text + (r >> 25), 8 + (r >> 24) % 120);
+      }
+      double t = std::chrono::duration<double>(Clock::now() - start).count();
+      // Find bin
+      for (k = 0; k < LatencyBins - 1 && t >= 0.125E-6 * (1 << k); k++) {}
+      histogram[k]++;
+   }
+   return std::chrono::duration<double>(Clock::now() - start0).count();
+}
+
+// Substring search benchmark. Searches a corpus of log lines for some
+// substrings with SearchForSubstring and with strstr. Compile with
+// -DUSE_SIMD_SEARCH to compare the built-in SIMD search with strstr.
+void SearchBenchmark() {
+   const int NumLines = 100000;        // Number of log lines
+   const int Repeat = 10;              // Number of times to search all lines
+   static const char * Levels[] = {"INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+   static const char * Paths[] = {"/api/v1/items", "/api/v1/users", "/static/app.js", "/health", "/api/v2/orders"};
+   static const char * Patterns[] = {"ERROR", "status=503", "/api/v2/orders", "user_agent=curl", "timeout"};
+   const int NumPatterns = sizeof(Patterns) / sizeof(*Patterns);
+   unsigned int r = 1;                 // Random number
+   int i, k, m;
+   StringPoolS lines;
+
+   // Make log lines
+   for (i = 0; i < NumLines; i++) {
+      r = r * 1103515245 + 12345;
+      lines[i].Printf("2026-10-19T%02u:%02u:%02u.%03uZ %-5s [worker-%u] GET %s status=%u bytes=%u "
+         "latency_ms=%u client=10.%u.%u.%u user_agent=Mozilla/5.0 request_id=%08x",
+         i / 3600 % 24, i / 60 % 60, i % 60, r % 1000, Levels[(r >> 8) % 6], (r >> 11) % 16,
+         Paths[(r >> 15) % 5], (r >> 18) % 50 ? 200 : 503, (r >> 4) % 100000, (r >> 20) % 500,
+         r >> 24, (r >> 16) & 255, (r >> 8) & 255, r * 2654435761u);
+   }
+
+   printf("\n\nSearch in %i log lines, ns per line:", NumLines);
+   printf("\n%-20s %8s %8s %8s", "substring", "found", "Search", "strstr");
+   for (k = 0; k < NumPatterns; k++) {
+      int found1 = 0, found2 = 0;
+      Clock::time_point start = Clock::now();
+      for (m = 0; m < Repeat; m++) {
+         for (i = 0; i < NumLines; i++) {
+            found1 += lines[i].SearchForSubstring(Patterns[k]) >= 0;
+         }
+      }
+      double time1 = std::chrono::duration<double>(Clock::now() - start).count();
+      start = Clock::now();
+      for (m = 0; m < Repeat; m++) {
+         for (i = 0; i < NumLines; i++) {
+            found2 += strstr(lines[i], Patterns[k]) != 0;
+         }
+      }
+      double time2 = std::chrono::duration<double>(Clock::now() - start).count();
+      if (found1 != found2) printf("\nError: different results");
+      printf("\n%-20s %8i %8.1f %8.1f", Patterns[k], found1 / Repeat,
+         time1 * 1E9 / NumLines / Repeat, time2 * 1E9 / NumLines / Repeat);
+   }
+   printf("\n");
+}
+
 int main() {
    int i, j, n;                        // Indices
 
@@ -657,5 +1015,21 @@ int main() {
    // causes a re-allocation of memory. A string should always be 
    // identified by its number, not by a pointer.
 
+   // Benchmark of latency with and without incremental garbage collection
+   long long hist1[LatencyBins], hist2[LatencyBins];
+   double time1 = LatencyHistogram(hist1, false);
+   double time2 = LatencyHistogram(hist2, true);
+   printf("\n\nLatency of Set and Concatenate:");
+   printf("\n  time below   stop-the-world  incremental");
+   for (i = 0; i < LatencyBins; i++) {
+      if (hist1[i] || hist2[i]) {
+         printf("\n%10.3f us %14lli %12lli", 0.125 * (1 << i), hist1[i], hist2[i]);
+      }
+   }
+   printf("\n total time %13.3f s %10.3f s\n", time1, time2);
+
+   // Benchmark of SearchForSubstring
+   SearchBenchmark();
+
    return 0;
 }
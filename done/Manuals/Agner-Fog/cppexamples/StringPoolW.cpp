@@ -1,14 +1,14 @@
 /**************************  StringPoolW.cpp  *********************************
 * Author:        Agner Fog
 * Date created:  2008-06-12
-* Last modified: 2011-07-29
+* Last modified: 2026-10-19
 * Description:
 * Defines memory pool for storing wide-character strings of arbitrary length.
 * Note: Works only in Windows!
 *
 * The latest version of this file is available at:
 * www.agner.org/optimize/cppexamples.zip
-* (c) 2008-2011 GNU General Public License www.gnu.org/copyleft/gpl.html
+* (c) 2008-2026 GNU General Public License www.gnu.org/copyleft/gpl.html
 *******************************************************************************
 *
 * This string pool is a useful replacement for string classes such as 'wstring' 
@@ -47,6 +47,18 @@
 * more than the double size and move all strings to the new block. Garbage
 * collection takes place only when a new memory block is allocated.
 *
+* Moving all strings at once can take a long time when the pool is big. Call
+* SetIncremental to avoid such pauses. In incremental mode, a new memory
+* block is allocated already when the old block is 3/4 full, and the strings
+* are moved to the new block a few at a time during the following calls to
+* Set and Concatenate. See StringPoolL.cpp for details.
+*
+* SearchForSubstring uses wcsstr from the standard library. Define
+* USE_SIMD_SEARCH to use a built-in search with AVX2 instructions instead, if
+* these are enabled in the compiler options (e.g. /arch:AVX2 or -mavx2), or
+* SSE4.2 instructions if these are enabled and wchar_t is 16 bits. Measure
+* whether it is faster than wcsstr in your compiler's library.
+*
 * Note that you should never store a pointer to a string in the string pool
 * because the pointer will become invalid in case the assignment or
 * modification of another string causes the memory to be re-allocated.
@@ -74,11 +86,23 @@
 #define _CRT_SECURE_NO_WARNINGS   // Avoid warning for vsnprintf function in MS compiler
 #include <memory.h>               // For memcpy and memset
 #include <string.h>               // For strlen, strcmp, strchr
+#include <wchar.h>                // For wcslen, wcscmp, wcsstr
 #include <stdlib.h>               // For exit in Error function
 #include <stdarg.h>               // For va_list, va_start
 #include <stdio.h>                // Needed for example only
+#include <chrono>                 // Needed for example only
 //#include <varargs.h>            // Include varargs.h for va_list, va_start only if required by your system
 
+#if defined(USE_SIMD_SEARCH) && (defined(__AVX2__) || (defined(__SSE4_2__) && WCHAR_MAX <= 0xFFFF))
+#define  SIMD_SEARCH              // Use built-in SIMD substring search
+#include <immintrin.h>            // For SIMD substring search
+#endif
+#if defined(SIMD_SEARCH) && !defined(__AVX2__)
+#define  MEM_PADDING_W 7          // SSE4.2 search reads up to 7 characters beyond a string
+#else
+#define  MEM_PADDING_W 0
+#endif
+
 
 // Define pointer to zero-terminated string
 typedef wchar_t const * PWChar;
@@ -130,11 +154,14 @@ public:
    void Concatenate(int i, PWChar s);  // Concatenate strings. Used by StringElementW 
    void ResizeBuf(int newsize);        // Allocate memory for string space
    void ResizeNum(int newsize);        // Allocate memory for string indices
+   void SetIncremental(int minsize = 1 << 19); // Incremental garbage collection when Buffer is bigger than minsize characters. 0 = off
    // Define desired allocation sizes
    enum DefineSizes {
       AllocateSpace1 = 8192,           // Minimum number of bytes to allocate in string buffer 
       AllocateSpace2 = 1024,           // Minimum number of indices to allocate in offsets buffer
-      FormatLength   = 1023};          // Maximum length of strings written with Printf
+      FormatLength   = 1023,           // Maximum length of strings written with Printf
+      MemPadding     = MEM_PADDING_W,  // Memory buffer padding, in characters
+      MoveQuantum    = 128};           // Minimum number of characters moved per operation in incremental mode
 protected:
    wchar_t * Get(int i) const;         // Read string. Used only from StringElementW 
    void Error(int message,int i) const;// Produce fatal error message.
@@ -148,6 +175,21 @@ private:
    int GarbageSize;                    // Total size of garbage in Buffer
    int Top;                            // Highest used Offset
    int Num;                            // Number of strings = highest used index in Offsets + 1
+   // Incremental garbage collection:
+   wchar_t * MoveBuffer;               // Old Buffer while strings are moved from it
+   int MoveBufferSize;                 // Size of MoveBuffer
+   int MoveDataSize;                   // Used part of MoveBuffer
+   int MoveTop;                        // Highest used Offset in MoveBuffer
+   int MoveRate;                       // Characters to move per character stored
+   int IncrementalMin;                 // Minimum BufferSize for incremental garbage collection. 0 = off
+   int MoveNext;                       // Strings below this index are in Buffer, the rest in MoveBuffer
+   enum {MoveIdle = 0x7FFFFFFF};       // Value of MoveNext when no strings are being moved
+   wchar_t * Base(int i) const {       // Buffer containing string i
+      return i < MoveNext ? Buffer : MoveBuffer;}
+   void Collect(int len);              // Incremental garbage collection before storing len characters
+   void StartMove();                   // Start moving strings to a new Buffer
+   void Move(size_t quota);            // Move strings from MoveBuffer to Buffer
+   void ReleaseOld();                  // Release OldBuffer and MoveBuffer when no longer needed
    wchar_t * Allocate(int i, int len); // Make space for a new string
    StringPoolW(StringPoolW &){};       // Private copy constructor to prevent copying
    void operator = (StringPoolW &){};  // Private operator = to prevent copying
@@ -181,6 +223,7 @@ inline bool operator  > (StringPoolW::StringElementW const & a, StringPoolW::Str
 StringPoolW::StringPoolW() {
    // Set everything to zero
    memset(this, 0, sizeof(*this));
+   MoveNext = MoveIdle;
 }
 
 
@@ -189,6 +232,7 @@ StringPoolW::~StringPoolW() {
    // Free allocated memory
    if (Buffer)    delete[] Buffer;
    if (OldBuffer) delete[] OldBuffer;
+   if (MoveBuffer) delete[] MoveBuffer;
    if (Offsets)   delete[] Offsets;
    // Set everything to zero
    memset(this, 0, sizeof(*this));
@@ -199,8 +243,15 @@ StringPoolW::~StringPoolW() {
 void StringPoolW::Clear() {
    // Set all offsets to zero
    if (Offsets) memset(Offsets, 0, Num * sizeof(*Offsets));
-   // Indicate that Buffer is empty, but do not deallocate
+   // Stop moving strings
+   if (MoveBuffer) {
+      delete[] MoveBuffer;  MoveBuffer = 0;
+   }
+   MoveNext = MoveIdle;
+   // Indicate that Buffer is empty, but do not deallocate.
+   // Keep the empty string at offset 0
    DataSize = GarbageSize = 0;
+   if (Buffer) DataSize = Top = 1;
 }
 
 
@@ -221,19 +272,20 @@ void StringPoolW::Set(int i, PWChar s) {
    if (Len == 0) {
       // Clear string
       if (Offsets[i]) {
-         GarbageSize += wcslen(Buffer + Offsets[i]) + 1;
+         // Garbage in MoveBuffer is not counted
+         if (i < MoveNext) GarbageSize += wcslen(Buffer + Offsets[i]) + 1;
          Offsets[i] = 0;
       }
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(Len);
    // Make space for string
    wchar_t * p = Allocate(i, Len);
    // Insert string
    memcpy(p, s, (Len+1)*sizeof(wchar_t));
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -252,11 +304,14 @@ void StringPoolW::Set(int i, PWChar s, int Len) {
    if (Len <= 0) {
       // Clear string
       if (Offsets[i]) {
-         GarbageSize += wcslen(Buffer + Offsets[i]) + 1;
+         // Garbage in MoveBuffer is not counted
+         if (i < MoveNext) GarbageSize += wcslen(Buffer + Offsets[i]) + 1;
          Offsets[i] = 0;
       }
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(Len);
    // Make space for string
    wchar_t * p = Allocate(i, Len);
    // Insert string
@@ -264,9 +319,7 @@ void StringPoolW::Set(int i, PWChar s, int Len) {
    // Zero-terminate
    p[Len] = 0;
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -285,19 +338,19 @@ void StringPoolW::Concatenate(int i, PWChar s) {
       Set(i, s);
       return;
    }
+   // Move some strings if incremental garbage collection is on
+   if (IncrementalMin) Collect(len2);
    // Length of first string
-   len1 = wcslen(Buffer + Offsets[i]);
+   len1 = wcslen(Get(i));
    // Remember position of string1
-   PWChar string1 = Buffer + Offsets[i];
+   PWChar string1 = Get(i);
    // Make space for combined string
    wchar_t * p = Allocate(i, len1 + len2);
    // Copy strings
    memcpy(p, string1, len1 * sizeof(wchar_t));
    memcpy(p + len1, s, (len2+1) * sizeof(wchar_t));
    // Release OldBuffer if any
-   if (OldBuffer) {
-      delete[] OldBuffer;  OldBuffer = 0;
-   }
+   ReleaseOld();
 }
 
 
@@ -306,13 +359,17 @@ void StringPoolW::ResizeBuf(int newsize) {
    int i;                              // Loop counter
    int DataSize2 = 0;                  // Used part of buffer after garbage collection
    int Strlen;                         // Length of current string
+   int Live = DataSize - GarbageSize;  // Size of strings to copy, at most
+
+   // Strings that have not been moved yet are copied from MoveBuffer
+   if (MoveNext != MoveIdle) Live += MoveDataSize;
 
    // Decide new size
-   if (newsize < (DataSize - GarbageSize) * 2 + AllocateSpace1) {
-       newsize = (DataSize - GarbageSize) * 2 + AllocateSpace1;
+   if (newsize < Live * 2 + AllocateSpace1) {
+       newsize = Live * 2 + AllocateSpace1;
    }
    // Allocate new larger block
-   wchar_t * Buffer2 = new wchar_t [newsize + 1];
+   wchar_t * Buffer2 = new wchar_t [newsize + 1 + MemPadding];
    if (Buffer2 == 0) Error(3, newsize + 1);// Allocation failed
 
    // Make empty string at offset 0. This will be used for all empty strings
@@ -324,10 +381,10 @@ void StringPoolW::ResizeBuf(int newsize) {
       for (i = 0; i < Num; i++) {
          if (Offsets[i]) {
             // Length of string
-            Strlen = wcslen(Buffer + Offsets[i]);
+            Strlen = wcslen(Base(i) + Offsets[i]);
             if (Strlen) {
                // String is not empty, copy it
-               memcpy (Buffer2 + DataSize2, Buffer + Offsets[i], (Strlen+1) * sizeof(wchar_t));
+               memcpy (Buffer2 + DataSize2, Base(i) + Offsets[i], (Strlen+1) * sizeof(wchar_t));
                // Store new offset
                Offsets[i] = Top = DataSize2;
                // Offset to next
@@ -347,6 +404,10 @@ void StringPoolW::ResizeBuf(int newsize) {
       // contain a string being copied. Remember to delete Oldbuffer
       // after new string has been stored
       OldBuffer = Buffer;
+
+      // All strings have been moved out of MoveBuffer. It is released
+      // together with OldBuffer
+      MoveNext = MoveIdle;
    }
 
    // Save new buffer
@@ -396,7 +457,7 @@ wchar_t * StringPoolW::Get(int i) const {
       Error(1, i);      
    }
    // Return pointer
-   return Buffer + Offsets[i];
+   return Base(i) + Offsets[i];
 }
 
 
@@ -432,14 +493,32 @@ wchar_t * StringPoolW::Allocate(int i, int len) {
    // This is allready done by Set or Concatenate before calling Allocate:
    // if (i >= OffsetsSize) ResizeNum(i+1); 
 
+   if (i >= MoveNext) {
+      // String i has not been moved yet. Keep it in MoveBuffer
+      if (Offsets[i] && (int)Offsets[i] == MoveTop && MoveTop + len + 1 <= MoveBufferSize) {
+         // This is last in MoveBuffer. Can grow without overwriting other strings
+         MoveDataSize = MoveTop + len + 1;
+         return MoveBuffer + MoveTop;
+      }
+      if (Offsets[i] && (int)wcslen(MoveBuffer + Offsets[i]) >= len) {
+         // New string fits into same space
+         return MoveBuffer + Offsets[i];
+      }
+      if (MoveDataSize + len + 1 <= MoveBufferSize) {
+         // Put new string at end of MoveBuffer
+         Offsets[i] = MoveTop = MoveDataSize;
+         MoveDataSize += len + 1;
+         return MoveBuffer + MoveTop;
+      }
+      // MoveBuffer is full. This can only happen if strings are moved
+      // slower than expected. Move the rest now and continue below
+      Move((size_t)(-1));
+   }
+
    if (Offsets[i]) {
       // Index i allready has a string
-      if (Offsets[i] == Top) {
+      if (Offsets[i] == Top && Top + len + 1 <= BufferSize) {
          // This is last in Buffer. Can grow without overwriting other strings
-         if (Top + len + 1 > BufferSize) {
-            // Buffer not big enough
-            ResizeBuf(Top + len + 1);
-         }
          // Reserve size
          DataSize = Top + len + 1;
          // Return pointer. Offsets[i] unchanged
@@ -469,6 +548,104 @@ wchar_t * StringPoolW::Allocate(int i, int len) {
 };
 
 
+// Turn on incremental garbage collection for Buffer sizes bigger than minsize
+// characters. minsize = 0 turns it off
+void StringPoolW::SetIncremental(int minsize) {
+   // Finish any current move before turning off
+   if (minsize == 0 && MoveNext != MoveIdle) {
+      Move((size_t)(-1));  ReleaseOld();
+   }
+   IncrementalMin = minsize;
+}
+
+
+// Incremental garbage collection. Called by Set and Concatenate before
+// storing a string of length len
+void StringPoolW::Collect(int len) {
+   if (MoveNext == MoveIdle) {
+      // Start moving strings when Buffer is 3/4 full
+      if (BufferSize < IncrementalMin || DataSize < BufferSize - BufferSize / 4 || MoveBuffer) return;
+      StartMove();
+   }
+   // Move strings in proportion to the size of the new string
+   Move((size_t)MoveRate * (len + 1) + MoveQuantum);
+}
+
+
+// Allocate a new Buffer and start moving strings to it.
+// See StringPoolL::StartMove for an explanation of the sizes.
+// All sizes are in characters. An index counts as one character
+void StringPoolW::StartMove() {
+   // Work to do is the size of live strings plus the number of indices
+   // that must be checked
+   int Work = DataSize - GarbageSize + Num;
+   // Free space in old Buffer
+   int Free = BufferSize - DataSize;
+
+   // New Buffer
+   int newsize = Work * 3 + AllocateSpace1;
+   wchar_t * Buffer2 = new wchar_t [newsize + 1 + MemPadding];
+   if (Buffer2 == 0) Error(3, newsize + 1);// Allocation failed
+
+   // Make empty string at offset 0. This will be used for all empty strings
+   Buffer2[0] = 0;
+
+   // The old Buffer becomes MoveBuffer
+   MoveBuffer = Buffer;  MoveBufferSize = BufferSize;
+   MoveDataSize = DataSize;  MoveTop = Top;
+   MoveRate = Work / (Free + 1) + 1;
+   MoveNext = 0;
+
+   // Save new buffer
+   Buffer = Buffer2;  BufferSize = newsize + 1;
+   DataSize = Top = 1;  GarbageSize = 0;
+}
+
+
+// Move strings from MoveBuffer to Buffer until quota characters have been
+// moved. Each index checked counts as one character
+void StringPoolW::Move(size_t quota) {
+   size_t Moved = 0;                   // Characters moved so far
+   int Size;                           // Size of current string
+
+   while (MoveNext < Num && Moved < quota) {
+      if (Offsets[MoveNext]) {
+         Size = (int)wcslen(MoveBuffer + Offsets[MoveNext]) + 1;
+         if (DataSize + Size > BufferSize) {
+            // Buffer is full. Copy everything to a bigger Buffer.
+            // This finishes the move
+            ResizeBuf(DataSize + Size);
+            return;
+         }
+         memcpy(Buffer + DataSize, MoveBuffer + Offsets[MoveNext], Size * sizeof(wchar_t));
+         // Store new offset
+         Offsets[MoveNext] = Top = DataSize;
+         DataSize += Size;  Moved += Size;
+      }
+      Moved++;
+      MoveNext++;
+   }
+   if (MoveNext >= Num) {
+      // All strings have been moved. MoveBuffer is released by ReleaseOld
+      // after the current string has been stored
+      MoveNext = MoveIdle;
+   }
+}
+
+
+// Release OldBuffer, and MoveBuffer if all strings have been moved out of it.
+// Called after a new string has been stored, because the string may have
+// been copied from one of these buffers
+void StringPoolW::ReleaseOld() {
+   if (OldBuffer) {
+      delete[] OldBuffer;  OldBuffer = 0;
+   }
+   if (MoveBuffer && MoveNext == MoveIdle) {
+      delete[] MoveBuffer;  MoveBuffer = 0;
+   }
+}
+
+
 // Format string using printf style formatting
 StringPoolW::StringElementW const & StringPoolW::StringElementW::Printf(const wchar_t * format, ...) {
    // Temporary buffer for new string. 
@@ -495,11 +672,122 @@ int StringPoolW::StringElementW::Write(FILE * f) {
 }
 
 
+#if defined(SIMD_SEARCH) && defined(__AVX2__)
+
+// Index of lowest set bit. x must be nonzero
+static inline int StringPoolWBitScan(unsigned int x) {
+#ifdef _MSC_VER
+   unsigned long i;
+   _BitScanForward(&i, x);
+   return (int)i;
+#else
+   return __builtin_ctz(x);
+#endif
+}
+
+// Search for substring n in string h.
+// Returns the position of the substring, or -1 if not found.
+// The first and the last character of n are compared with 32 bytes of h
+// at a time. The whole substring is compared only at the positions where
+// both match. Works with 16-bit and 32-bit wchar_t
+static int StringPoolWSearch(PWChar h, PWChar n) {
+   const int Step = 32 / sizeof(wchar_t);  // Characters per vector
+   // Mask for the lowest bit of each character in a byte mask
+   const unsigned int Lowbits = sizeof(wchar_t) == 2 ? 0x55555555 : 0x11111111;
+   int hlen = (int)wcslen(h);          // Length of h
+   int nlen = (int)wcslen(n);          // Length of n
+   int i = 0;                          // Position in h
+   __m256i first, last, f, l;
+   if (nlen == 0) return 0;            // Empty substring is found at position 0
+   if (nlen > hlen) return -1;         // Substring longer than string
+   if (sizeof(wchar_t) == 2) {
+      first = _mm256_set1_epi16((short)n[0]);
+      last  = _mm256_set1_epi16((short)n[nlen-1]);
+   }
+   else {
+      first = _mm256_set1_epi32((int)n[0]);
+      last  = _mm256_set1_epi32((int)n[nlen-1]);
+   }
+   int end = hlen - nlen + 1;          // Number of possible positions
+   if (end >= Step) {
+      unsigned int ignore = 0;         // Mask for positions already checked
+      for (;;) {
+         f = _mm256_loadu_si256((__m256i const *)(h + i));
+         l = _mm256_loadu_si256((__m256i const *)(h + i + nlen - 1));
+         if (sizeof(wchar_t) == 2) {
+            f = _mm256_cmpeq_epi16(first, f);  l = _mm256_cmpeq_epi16(last, l);
+         }
+         else {
+            f = _mm256_cmpeq_epi32(first, f);  l = _mm256_cmpeq_epi32(last, l);
+         }
+         unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(f, l)) & Lowbits & ~ignore;
+         while (mask) {
+            int j = StringPoolWBitScan(mask) / sizeof(wchar_t);
+            if (memcmp(h + i + j, n, nlen * sizeof(wchar_t)) == 0) return i + j;
+            mask &= mask - 1;          // Clear lowest bit
+         }
+         if (i + Step >= end) return -1;
+         i += Step;
+         if (i + Step > end) {
+            // The last block overlaps the previous block
+            ignore = (1u << ((i - (end - Step)) * sizeof(wchar_t))) - 1;
+            i = end - Step;
+         }
+      }
+   }
+   // String too short for a whole block
+   for (; i < end; i++) {
+      if (h[i] == n[0] && memcmp(h + i, n, nlen * sizeof(wchar_t)) == 0) return i;
+   }
+   return -1;
+}
+
+#elif defined(SIMD_SEARCH)
+
+// Search for substring n in string h. Requires 16-bit wchar_t.
+// Returns the position of the substring, or -1 if not found.
+// The pcmpistri instruction finds the first position in a 16-byte block of
+// h where the first 8 characters of n match, including a partial match at
+// the end of the block. The whole substring is compared at this position.
+// This reads up to 7 characters beyond the end of h. StringPoolW has
+// MemPadding characters extra at the end of Buffer for this purpose
+static int StringPoolWSearch(PWChar h, PWChar n) {
+   const int mode = _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ORDERED;
+   int nlen = (int)wcslen(n);          // Length of n
+   int i = 0;                          // Position in h
+   int j;                              // Position in block
+   wchar_t nbuf[8] = {0};              // First 8 characters of n
+   if (nlen == 0) return 0;            // Empty substring is found at position 0
+   memcpy(nbuf, n, (nlen < 8 ? nlen : 8) * sizeof(wchar_t));
+   __m128i nv = _mm_loadu_si128((__m128i const *)nbuf);
+   for (;;) {
+      __m128i hv = _mm_loadu_si128((__m128i const *)(h + i));
+      j = _mm_cmpistri(nv, hv, mode);
+      if (j < 8) {
+         // Possible match
+         if (wcsncmp(h + i + j, n, nlen) == 0) return i + j;
+         i += j + 1;                   // Continue after this position
+      }
+      else if (_mm_cmpistrz(nv, hv, mode)) {
+         return -1;                    // End of h
+      }
+      else {
+         i += 8;                       // Next block
+      }
+   }
+}
+
+#endif
+
+
 // Search in string for any substring.
 // The return value is the position of the substring if found,
 // or -1 if not found.
 int StringPoolW::StringElementW::SearchForSubstring(PWChar s) {
    PWChar h = arr.Get(index);
+#ifdef SIMD_SEARCH
+   return StringPoolWSearch(h, s);
+#else
    PWChar n = wcsstr(h, s);
    if (n) {
       // Substring found. Return offset
@@ -507,6 +795,7 @@ int StringPoolW::StringElementW::SearchForSubstring(PWChar s) {
    }
    // Not found
    return -1;
+#endif
 }
 
 
@@ -544,6 +833,97 @@ wchar_t & StringPoolW::StringElementW::operator[] (int i) {
 // To run this example, just compile this file for console mode and run it.
 // You may play with this example as you like
 
+// Latency benchmark. Stores random strings at random indices and counts the
+// time of each Set or Concatenate in a histogram. Bin k counts operations
+// that take less than 2^k * 0.125 microseconds
+const int LatencyBins = 24;
+
+typedef std::chrono::steady_clock Clock;
+
+// Returns total time in seconds
+double LatencyHistogram(long long * histogram, bool incremental) {
+   const int NumStrings = 1000000;     // Number of string indices used
+   const int NumOperations = 5000000;  // Number of Set and Concatenate
+   wchar_t text[256];                  // Random text
+   unsigned int r = 1;                 // Random number
+   int i, k;
+
+   for (k = 0; k < 255; k++) {
+      r = r * 1103515245 + 12345;  text[k] = L'a' + (r >> 16) % 26;
+   }
+   text[255] = 0;
+   for (k = 0; k < LatencyBins; k++) histogram[k] = 0;
+
+   StringPoolW strings;
+   if (incremental) strings.SetIncremental();
+   Clock::time_point start0 = Clock::now();
+   for (int n = 0; n < NumOperations; n++) {
+      r = r * 1103515245 + 12345;
+      i = (r >> 4) % NumStrings;
+      Clock::time_point start = Clock::now();
+      if ((r & 3) == 0 && i < strings.GetNum()) {
+         strings[i] += text + 240;     // Concatenate 15 characters
+      }
+      else {
+         strings.Set(i, text + (r >> 25), 8 + (r >> 24) % 120);
+      }
+      double t = std::chrono::duration<double>(Clock::now() - start).count();
+      // Find bin
+      for (k = 0; k < LatencyBins - 1 && t >= 0.125E-6 * (1 << k); k++) {}
+      histogram[k]++;
+   }
+   return std::chrono::duration<double>(Clock::now() - start0).count();
+}
+
+// Substring search benchmark. Searches a corpus of log lines for some
+// substrings with SearchForSubstring and with wcsstr. Compile with
+// -DUSE_SIMD_SEARCH to compare the built-in SIMD search with wcsstr.
+void SearchBenchmark() {
+   const int NumLines = 100000;        // Number of log lines
+   const int Repeat = 10;              // Number of times to search all lines
+   static const wchar_t * Levels[] = {L"INFO", L"INFO", L"INFO", L"DEBUG", L"WARN", L"ERROR"};
+   static const wchar_t * Paths[] = {L"/api/v1/items", L"/api/v1/users", L"/static/app.js", L"/health", L"/api/v2/orders"};
+   static const wchar_t * Patterns[] = {L"ERROR", L"status=503", L"/api/v2/orders", L"user_agent=curl", L"timeout"};
+   const int NumPatterns = sizeof(Patterns) / sizeof(*Patterns);
+   unsigned int r = 1;                 // Random number
+   int i, k, m;
+   StringPoolW lines;
+
+   // Make log lines
+   for (i = 0; i < NumLines; i++) {
+      r = r * 1103515245 + 12345;
+      lines[i].Printf(L"2026-10-19T%02u:%02u:%02u.%03uZ %-5ls [worker-%u] GET %ls status=%u bytes=%u "
+         L"latency_ms=%u client=10.%u.%u.%u user_agent=Mozilla/5.0 request_id=%08x",
+         i / 3600 % 24, i / 60 % 60, i % 60, r % 1000, Levels[(r >> 8) % 6], (r >> 11) % 16,
+         Paths[(r >> 15) % 5], (r >> 18) % 50 ? 200 : 503, (r >> 4) % 100000, (r >> 20) % 500,
+         r >> 24, (r >> 16) & 255, (r >> 8) & 255, r * 2654435761u);
+   }
+
+   wprintf(L"\n\nSearch in %i log lines, ns per line:", NumLines);
+   wprintf(L"\n%-20ls %8ls %8ls %8ls", L"substring", L"found", L"Search", L"wcsstr");
+   for (k = 0; k < NumPatterns; k++) {
+      int found1 = 0, found2 = 0;
+      Clock::time_point start = Clock::now();
+      for (m = 0; m < Repeat; m++) {
+         for (i = 0; i < NumLines; i++) {
+            found1 += lines[i].SearchForSubstring(Patterns[k]) >= 0;
+         }
+      }
+      double time1 = std::chrono::duration<double>(Clock::now() - start).count();
+      start = Clock::now();
+      for (m = 0; m < Repeat; m++) {
+         for (i = 0; i < NumLines; i++) {
+            found2 += wcsstr(lines[i], Patterns[k]) != 0;
+         }
+      }
+      double time2 = std::chrono::duration<double>(Clock::now() - start).count();
+      if (found1 != found2) wprintf(L"\nError: different results");
+      wprintf(L"\n%-20ls %8i %8.1f %8.1f", Patterns[k], found1 / Repeat,
+         time1 * 1E9 / NumLines / Repeat, time2 * 1E9 / NumLines / Repeat);
+   }
+   wprintf(L"\n");
+}
+
 int main() {
    int i, j, n;                        // Indices
 
@@ -625,5 +1005,21 @@ int main() {
    // causes a re-allocation of memory. A string should always be 
    // identified by its number, not by a pointer.
 
+   // Benchmark of latency with and without incremental garbage collection
+   long long hist1[LatencyBins], hist2[LatencyBins];
+   double time1 = LatencyHistogram(hist1, false);
+   double time2 = LatencyHistogram(hist2, true);
+   wprintf(L"\n\nLatency of Set and Concatenate:");
+   wprintf(L"\n  time below   stop-the-world  incremental");
+   for (i = 0; i < LatencyBins; i++) {
+      if (hist1[i] || hist2[i]) {
+         wprintf(L"\n%10.3f us %14lli %12lli", 0.125 * (1 << i), hist1[i], hist2[i]);
+      }
+   }
+   wprintf(L"\n total time %13.3f s %10.3f s\n", time1, time2);
+
+   // Benchmark of SearchForSubstring
+   SearchBenchmark();
+
 	return 0;
 }
@@ -30,7 +30,16 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <vector>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <stdio.h>
+#endif
 
 #ifdef FN_COMPILE_NO_SIMD_FALLBACK
 #define SIMD_LEVEL_H FN_NO_SIMD_FALLBACK
@@ -400,7 +409,102 @@ float* FastNoiseSIMD::GetNoiseSet(int xStart, int yStart, int zStart, int xSize,
 	return noiseSet;
 }
 
+static bool IsPowerOf2(int i)
+{
+	return i > 0 && (i & (i - 1)) == 0;
+}
+
+// Interleaves the low 10 bits of each axis, z is the lowest bit
+static int MortonIndex(int x, int y, int z)
+{
+	int index = 0;
+
+	for (int bit = 0; bit < 10; bit++)
+	{
+		index |= ((z >> bit) & 1) << (bit * 3);
+		index |= ((y >> bit) & 1) << (bit * 3 + 1);
+		index |= ((x >> bit) & 1) << (bit * 3 + 2);
+	}
+	return index;
+}
+
+int FastNoiseSIMD::GetLayoutIndex(OutputLayout layout, int x, int y, int z, int /*xSize*/, int ySize, int zSize)
+{
+	switch (layout)
+	{
+	case Morton:
+		return MortonIndex(x, y, z);
+	case Brick:
+		return ((((x >> 3) * (ySize >> 3) + (y >> 3)) * (zSize >> 3) + (z >> 3)) << 9) | ((x & 7) << 6) | ((y & 7) << 3) | (z & 7);
+	default:
+		return (x * ySize + y) * zSize + z;
+	}
+}
+
 void FastNoiseSIMD::FillNoiseSet(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier)
+{
+	switch (m_outputLayout)
+	{
+	case Morton:
+	{
+		assert(xSize == ySize && ySize == zSize && IsPowerOf2(xSize) && xSize <= 1024);
+
+		// Any aligned power of 2 cube is contiguous in Morton order, blocks are generated linearly
+		// into a cache resident buffer and reordered straight into place
+		int blockSize = std::min(xSize, 8);
+		int blockVolume = blockSize * blockSize * blockSize;
+		float* blockSet = GetEmptySet(blockVolume);
+		int blockOrder[512];
+
+		for (int x = 0, i = 0; x < blockSize; x++)
+			for (int y = 0; y < blockSize; y++)
+				for (int z = 0; z < blockSize; z++)
+					blockOrder[i++] = MortonIndex(x, y, z);
+
+		for (int x = 0; x < xSize; x += blockSize)
+		{
+			for (int y = 0; y < ySize; y += blockSize)
+			{
+				for (int z = 0; z < zSize; z += blockSize)
+				{
+					FillLinearNoiseSet(blockSet, xStart + x, yStart + y, zStart + z, blockSize, blockSize, blockSize, scaleModifier);
+
+					float* block = noiseSet + MortonIndex(x, y, z);
+					for (int i = 0; i < blockVolume; i++)
+						block[blockOrder[i]] = blockSet[i];
+				}
+			}
+		}
+		FreeNoiseSet(blockSet);
+		break;
+	}
+	case Brick:
+	{
+		assert(!(xSize & 7) && !(ySize & 7) && !(zSize & 7));
+
+		// Bricks are linear internally so each one is generated in place
+		float* brick = noiseSet;
+
+		for (int x = 0; x < xSize; x += 8)
+		{
+			for (int y = 0; y < ySize; y += 8)
+			{
+				for (int z = 0; z < zSize; z += 8)
+				{
+					FillLinearNoiseSet(brick, xStart + x, yStart + y, zStart + z, 8, 8, 8, scaleModifier);
+					brick += 512;
+				}
+			}
+		}
+		break;
+	}
+	default:
+		FillLinearNoiseSet(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize, scaleModifier);
+		break;
+	}
+}
+
+void FastNoiseSIMD::FillLinearNoiseSet(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier)
 {
 	switch (m_noiseType)
 	{
@@ -439,6 +543,170 @@ void FastNoiseSIMD::FillNoiseSet(float* noiseSet, int xStart, int yStart, int zS
 	}
 }
 
+#ifdef __linux__
+// Reads a sysfs list such as "0-15,32-47"
+static std::vector<int> ReadSysfsList(const char* path)
+{
+	std::vector<int> list;
+	FILE* file = fopen(path, "r");
+
+	if (!file)
+		return list;
+
+	int first, last;
+	while (fscanf(file, "%d", &first) == 1)
+	{
+		last = first;
+		if (fscanf(file, "-%d", &last) != 1)
+			last = first;
+
+		for (int i = first; i <= last; i++)
+			list.push_back(i);
+
+		if (fgetc(file) != ',')
+			break;
+	}
+	fclose(file);
+
+	return list;
+}
+
+// Node IDs can have gaps, eg when a node has been taken offline
+static const std::vector<int>& GetNumaNodes()
+{
+	static const std::vector<int> nodes = ReadSysfsList("/sys/devices/system/node/online");
+	return nodes;
+}
+
+// Pins the calling thread to the CPUs of the node
+static void PinThreadToNumaNode(int node)
+{
+	char path[64];
+	sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+
+	for (int cpu : ReadSysfsList(path))
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &cpuSet);
+
+	if (CPU_COUNT(&cpuSet))
+		sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+}
+#endif
+
+int FastNoiseSIMD::GetNumaNodeCount()
+{
+#ifdef __linux__
+	return std::max((int)GetNumaNodes().size(), 1);
+#else
+	return 1;
+#endif
+}
+
+int FastNoiseSIMD::ParallelSlabs(int* slabStarts, int xSize, int ySize, int zSize, int threadCount) const
+{
+	if (threadCount <= 0)
+		threadCount = std::max((int)std::thread::hardware_concurrency(), 1);
+
+	// Brick slabs must be whole bricks to stay contiguous, Morton slabs are not contiguous at all
+	int unit = m_outputLayout == Brick ? 8 : 1;
+
+	// Every slab must start on a whole vector, aligned sets are written with aligned stores
+	// and the last vector of a slab is stored whole, past the end of the slab
+	int vectorSize = AlignedSize(1);
+	while (unit < vectorSize && (long long)unit * ySize * zSize % vectorSize != 0)
+		unit *= 2;
+
+	int units = std::max(xSize / unit, 1);
+	int workerCount = m_outputLayout == Morton ? 1 : std::min(threadCount, units);
+
+	if (slabStarts)
+	{
+		for (int i = 0; i < workerCount; i++)
+			slabStarts[i] = (int)((long long)units * i / workerCount) * unit;
+
+		slabStarts[workerCount] = xSize;
+	}
+	return workerCount;
+}
+
+int FastNoiseSIMD::ParallelWorkerNode(int worker, int workerCount) const
+{
+	if (m_parallelNumaNode >= 0)
+		return m_parallelNumaNode;
+
+#ifdef __linux__
+	if (GetNumaNodeCount() > 1)
+		return GetNumaNodes()[worker * GetNumaNodeCount() / workerCount];
+#else
+	(void)worker;
+	(void)workerCount;
+#endif
+	return 0;
+}
+
+int FastNoiseSIMD::GetParallelNumaNode(int xIndex, int xSize, int ySize, int zSize, int threadCount) const
+{
+	int workerCount = ParallelSlabs(nullptr, xSize, ySize, zSize, threadCount);
+	std::vector<int> slabStarts(workerCount + 1);
+	ParallelSlabs(slabStarts.data(), xSize, ySize, zSize, threadCount);
+
+	int worker = int(std::upper_bound(slabStarts.begin(), slabStarts.end() - 1, xIndex) - slabStarts.begin()) - 1;
+
+	return ParallelWorkerNode(std::max(worker, 0), workerCount);
+}
+
+float* FastNoiseSIMD::GetNoiseSetParallel(int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier, int threadCount)
+{
+	float* noiseSet = GetEmptySet(xSize, ySize, zSize);
+
+	FillNoiseSetParallel(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize, scaleModifier, threadCount);
+
+	return noiseSet;
+}
+
+void FastNoiseSIMD::FillNoiseSetParallel(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier, int threadCount)
+{
+	assert(noiseSet);
+
+	int workerCount = ParallelSlabs(nullptr, xSize, ySize, zSize, threadCount);
+
+	if (workerCount <= 1)
+	{
+		FillNoiseSet(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize, scaleModifier);
+		return;
+	}
+
+	std::vector<int> slabStarts(workerCount + 1);
+	ParallelSlabs(slabStarts.data(), xSize, ySize, zSize, threadCount);
+
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount);
+
+	for (int i = 0; i < workerCount; i++)
+	{
+		int node = ParallelWorkerNode(i, workerCount);
+		int xSlabStart = slabStarts[i];
+		int xSlabSize = slabStarts[i + 1] - xSlabStart;
+
+		workers.emplace_back([=]
+		{
+#ifdef __linux__
+			if (GetNumaNodeCount() > 1)
+				PinThreadToNumaNode(node);
+#else
+			(void)node;
+#endif
+			FillNoiseSet(noiseSet + (size_t)xSlabStart * ySize * zSize, xStart + xSlabStart, yStart, zStart, xSlabSize, ySize, zSize, scaleModifier);
+		});
+	}
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
 void FastNoiseSIMD::FillNoiseSet(float* noiseSet, FastNoiseVectorSet* vectorSet, float xOffset, float yOffset, float zOffset)
 {
 	switch (m_noiseType)
@@ -487,6 +755,187 @@ float* FastNoiseSIMD::GetSampledNoiseSet(int xStart, int yStart, int zStart, int
 	return noiseSet;
 }
 
+float** FastNoiseSIMD::GetNoisePyramid(int levelCount, int xCentre, int yCentre, int zCentre, int xSize, int ySize, int zSize, float scaleModifier)
+{
+	float** noiseSets = new float*[levelCount];
+
+	for (int level = 0; level < levelCount; level++)
+		noiseSets[level] = GetEmptySet(xSize, ySize, zSize);
+
+	FillNoisePyramid(noiseSets, levelCount, xCentre, yCentre, zCentre, xSize, ySize, zSize, scaleModifier);
+
+	return noiseSets;
+}
+
+void FastNoiseSIMD::FreeNoisePyramid(float** noiseSets, int levelCount)
+{
+	for (int level = 0; level < levelCount; level++)
+		FreeNoiseSet(noiseSets[level]);
+
+	delete[] noiseSets;
+}
+
+// Number of octaves on a level that are smooth enough at the next coarser level's sample spacing to be up-sampled
+// Perturbation warps the input of every sample, so with perturbation no octave is smooth enough
+int FastNoiseSIMD::PyramidSharedOctaves(int level, float scaleModifier) const
+{
+	if (m_perturbType != None)
+		return 0;
+
+	float axisScale = std::max(std::max(std::abs(m_xScale), std::abs(m_yScale)), std::abs(m_zScale));
+	float step = std::abs(m_frequency * scaleModifier) * axisScale * float(2 << level);
+
+	int octaves = 0;
+	while (octaves < m_octaves && step <= m_pyramidUpsampleStep)
+	{
+		step *= std::abs(m_lacunarity);
+		octaves++;
+	}
+	return octaves;
+}
+
+// Builds the trilinear taps along one axis, a fine sample always lands on or halfway between coarse samples
+static void PyramidAxisTaps(std::vector<int>& index, std::vector<float>& weight, int fineStart, int coarseStart, int size)
+{
+	index.resize(size);
+	weight.resize(size);
+
+	for (int i = 0; i < size; i++)
+	{
+		int coarse2 = fineStart + i - coarseStart * 2;
+		int i0 = coarse2 >> 1;
+		float t = (coarse2 & 1) ? 0.5f : 0.0f;
+
+		if (i0 < 0)
+		{
+			i0 = 0;
+			t = 0.0f;
+		}
+		else if (i0 >= size - 1)
+		{
+			i0 = std::max(size - 2, 0);
+			t = size > 1 ? 1.0f : 0.0f;
+		}
+		index[i] = i0;
+		weight[i] = t;
+	}
+}
+
+static void PyramidUpsample(float* fineSet, const float* coarseSet, const int fineStart[3], const int coarseStart[3], int xSize, int ySize, int zSize)
+{
+	std::vector<int> xIndex, yIndex, zIndex;
+	std::vector<float> xWeight, yWeight, zWeight;
+
+	PyramidAxisTaps(xIndex, xWeight, fineStart[0], coarseStart[0], xSize);
+	PyramidAxisTaps(yIndex, yWeight, fineStart[1], coarseStart[1], ySize);
+	PyramidAxisTaps(zIndex, zWeight, fineStart[2], coarseStart[2], zSize);
+
+	int yzSize = ySize * zSize;
+	int xStep = xSize > 1 ? yzSize : 0;
+	int yStep = ySize > 1 ? zSize : 0;
+	int zStep = zSize > 1 ? 1 : 0;
+	int index = 0;
+
+	for (int ix = 0; ix < xSize; ix++)
+	{
+		float xt = xWeight[ix];
+		const float* xRow = coarseSet + xIndex[ix] * yzSize;
+
+		for (int iy = 0; iy < ySize; iy++)
+		{
+			float yt = yWeight[iy];
+			const float* c00 = xRow + yIndex[iy] * zSize;
+			const float* c10 = c00 + xStep;
+			const float* c01 = c00 + yStep;
+			const float* c11 = c10 + yStep;
+
+			for (int iz = 0; iz < zSize; iz++)
+			{
+				int z0 = zIndex[iz];
+				int z1 = z0 + zStep;
+				float zt = zWeight[iz];
+
+				float v00 = c00[z0] + (c00[z1] - c00[z0]) * zt;
+				float v10 = c10[z0] + (c10[z1] - c10[z0]) * zt;
+				float v01 = c01[z0] + (c01[z1] - c01[z0]) * zt;
+				float v11 = c11[z0] + (c11[z1] - c11[z0]) * zt;
+
+				float v0 = v00 + (v01 - v00) * yt;
+				float v1 = v10 + (v11 - v10) * yt;
+
+				fineSet[index++] = v0 + (v1 - v0) * xt;
+			}
+		}
+	}
+}
+
+static void PyramidAdd(float* noiseSet, const float* addSet, int size)
+{
+	for (int i = 0; i < size; i++)
+		noiseSet[i] += addSet[i];
+}
+
+void FastNoiseSIMD::FillNoisePyramid(float** noiseSets, int levelCount, int xCentre, int yCentre, int zCentre, int xSize, int ySize, int zSize, float scaleModifier)
+{
+	assert(noiseSets);
+
+	bool fractal = m_noiseType == ValueFractal || m_noiseType == PerlinFractal || m_noiseType == SimplexFractal || m_noiseType == CubicFractal;
+
+	if (!fractal || levelCount <= 1 || PyramidSharedOctaves(0, scaleModifier) == 0)
+	{
+		for (int level = 0; level < levelCount; level++)
+		{
+			FillLinearNoiseSet(noiseSets[level], (xCentre >> level) - xSize / 2, (yCentre >> level) - ySize / 2, (zCentre >> level) - zSize / 2,
+				xSize, ySize, zSize, scaleModifier * float(1 << level));
+		}
+		return;
+	}
+
+	int size = xSize * ySize * zSize;
+
+	// Sum of the octaves the next finer level up-samples, for the current and the previous (coarser) level
+	float* lowSet = GetEmptySet(size);
+	float* coarseLowSet = GetEmptySet(size);
+	float* octaveSet = GetEmptySet(size);
+
+	int coarseStart[3] = { 0, 0, 0 };
+	int sharedOctaves = 0;
+
+	for (int level = levelCount - 1; level >= 0; level--)
+	{
+		float* noiseSet = noiseSets[level];
+		float levelScale = scaleModifier * float(1 << level);
+		int fineStart[3] = { (xCentre >> level) - xSize / 2, (yCentre >> level) - ySize / 2, (zCentre >> level) - zSize / 2 };
+
+		// Octaves [0, sharedOctaves) come from the coarser level
+		int octaveStart = sharedOctaves;
+		int finerShared = level > 0 ? std::max(PyramidSharedOctaves(level - 1, scaleModifier), octaveStart) : octaveStart;
+
+		if (octaveStart > 0)
+			PyramidUpsample(lowSet, coarseLowSet, fineStart, coarseStart, xSize, ySize, zSize);
+		else
+			std::fill(lowSet, lowSet + size, 0.0f);
+
+		// Octaves the finer level will share, evaluated here once
+		if (finerShared > octaveStart)
+		{
+			FillFractalOctaveSet(octaveSet, octaveStart, finerShared, fineStart[0], fineStart[1], fineStart[2], xSize, ySize, zSize, levelScale);
+			PyramidAdd(lowSet, octaveSet, size);
+		}
+
+		FillFractalOctaveSet(noiseSet, finerShared, m_octaves, fineStart[0], fineStart[1], fineStart[2], xSize, ySize, zSize, levelScale);
+		PyramidAdd(noiseSet, lowSet, size);
+
+		std::swap(lowSet, coarseLowSet);
+		std::copy(fineStart, fineStart + 3, coarseStart);
+		sharedOctaves = finerShared;
+	}
+
+	FreeNoiseSet(lowSet);
+	FreeNoiseSet(coarseLowSet);
+	FreeNoiseSet(octaveSet);
+}
+
 #define GET_SET(f) \
 float* FastNoiseSIMD::Get##f##Set(int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier)\
 {\
@@ -554,3 +1003,248 @@ void FastNoiseVectorSet::SetSize(int _size)
 	ySet = xSet + alignedSize;
 	zSet = ySet + alignedSize;
 }
+
+FastNoiseRingVolume::FastNoiseRingVolume(FastNoiseSIMD* noise, int xSize, int ySize, int zSize, float scaleModifier) :
+	m_noise(noise), m_scaleModifier(scaleModifier), m_xSize(xSize), m_ySize(ySize), m_zSize(zSize)
+{
+	assert(noise);
+	assert(xSize > 0 && ySize > 0 && zSize > 0);
+
+	m_data = FastNoiseSIMD::GetEmptySet(xSize, ySize, zSize);
+	Refresh();
+}
+
+FastNoiseRingVolume::~FastNoiseRingVolume()
+{
+	FastNoiseSIMD::FreeNoiseSet(m_data);
+}
+
+void FastNoiseRingVolume::Refresh()
+{
+	FillRegion(m_xOrigin, m_yOrigin, m_zOrigin, m_xSize, m_ySize, m_zSize);
+}
+
+void FastNoiseRingVolume::SetOrigin(int xOrigin, int yOrigin, int zOrigin)
+{
+	int xDelta = xOrigin - m_xOrigin;
+	int yDelta = yOrigin - m_yOrigin;
+	int zDelta = zOrigin - m_zOrigin;
+
+	m_xOrigin = xOrigin;
+	m_yOrigin = yOrigin;
+	m_zOrigin = zOrigin;
+
+	if (std::abs(xDelta) >= m_xSize || std::abs(yDelta) >= m_ySize || std::abs(zDelta) >= m_zSize)
+	{
+		Refresh();
+		return;
+	}
+
+	// Each axis fills its exposed slab across the part of the window the previous axes have not filled
+	int xKeep = m_xSize - std::abs(xDelta);
+	int yKeep = m_ySize - std::abs(yDelta);
+	int xKeepStart = xDelta > 0 ? xOrigin : xOrigin - xDelta;
+	int yKeepStart = yDelta > 0 ? yOrigin : yOrigin - yDelta;
+
+	if (xDelta > 0)
+		FillRegion(xOrigin + xKeep, yOrigin, zOrigin, xDelta, m_ySize, m_zSize);
+	else if (xDelta < 0)
+		FillRegion(xOrigin, yOrigin, zOrigin, -xDelta, m_ySize, m_zSize);
+
+	if (yDelta > 0)
+		FillRegion(xKeepStart, yOrigin + yKeep, zOrigin, xKeep, yDelta, m_zSize);
+	else if (yDelta < 0)
+		FillRegion(xKeepStart, yOrigin, zOrigin, xKeep, -yDelta, m_zSize);
+
+	if (zDelta > 0)
+		FillRegion(xKeepStart, yKeepStart, zOrigin + m_zSize - zDelta, xKeep, yKeep, zDelta);
+	else if (zDelta < 0)
+		FillRegion(xKeepStart, yKeepStart, zOrigin, xKeep, yKeep, -zDelta);
+}
+
+void FastNoiseRingVolume::FillRegion(int xStart, int yStart, int zStart, int xSize, int ySize, int zSize)
+{
+	float* noiseSet = FastNoiseSIMD::GetEmptySet(xSize, ySize, zSize);
+	m_noise->FillLinearNoiseSet(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize, m_scaleModifier);
+
+	// Each z row wraps at most once so it is copied in up to 2 runs
+	int zRing = Wrap(zStart, m_zSize);
+	int zFirst = std::min(zSize, m_zSize - zRing);
+	int index = 0;
+
+	for (int ix = 0; ix < xSize; ix++)
+	{
+		int xRow = Wrap(xStart + ix, m_xSize) * m_ySize;
+
+		for (int iy = 0; iy < ySize; iy++)
+		{
+			float* row = m_data + (xRow + Wrap(yStart + iy, m_ySize)) * m_zSize;
+
+			std::memcpy(row + zRing, noiseSet + index, zFirst * sizeof(float));
+			if (zFirst < zSize)
+				std::memcpy(row, noiseSet + index + zFirst, (zSize - zFirst) * sizeof(float));
+
+			index += zSize;
+		}
+	}
+
+	FastNoiseSIMD::FreeNoiseSet(noiseSet);
+}
+
+FastNoiseChunkGrid::FastNoiseChunkGrid(FastNoiseSIMD* noise, int xChunkSize, int yChunkSize, int zChunkSize, int apron, float scaleModifier) :
+	m_noise(noise), m_scaleModifier(scaleModifier), m_xChunkSize(xChunkSize), m_yChunkSize(yChunkSize), m_zChunkSize(zChunkSize), m_apron(apron)
+{
+	assert(noise);
+	assert(apron >= 0);
+	assert(xChunkSize > apron * 2 && yChunkSize > apron * 2 && zChunkSize > apron * 2);
+}
+
+float* FastNoiseChunkGrid::GetChunk(int xChunk, int yChunk, int zChunk)
+{
+	float* noiseSet = FastNoiseSIMD::GetEmptySet(GetXSetSize(), GetYSetSize(), GetZSetSize());
+
+	FillChunk(noiseSet, xChunk, yChunk, zChunk);
+
+	return noiseSet;
+}
+
+void FastNoiseChunkGrid::ClearCache()
+{
+	for (auto& slab : m_borderCache)
+		FastNoiseSIMD::FreeNoiseSet(slab.second.noiseSet);
+
+	m_borderCache.clear();
+}
+
+// One axis of a chunk: low border, core, high border
+// Border key 2 * n is shared by chunks n - 1 and n, core key 2 * n + 1 belongs to chunk n only
+struct ChunkAxisPiece
+{
+	int key;
+	int start;
+	int size;
+	int offset;
+	int border;
+};
+
+static void ChunkAxisPieces(ChunkAxisPiece* pieces, int chunk, int chunkSize, int apron)
+{
+	int chunkStart = chunk * chunkSize;
+
+	pieces[0] = { chunk * 2, chunkStart - apron, apron * 2, 0, 1 };
+	pieces[1] = { chunk * 2 + 1, chunkStart + apron, chunkSize - apron * 2, apron * 2, 0 };
+	pieces[2] = { chunk * 2 + 2, chunkStart + chunkSize - apron, apron * 2, chunkSize, 1 };
+}
+
+// Copies a block of z rows from a piece set of zPieceSize rows into the chunk set
+static void ChunkCopyPiece(float* noiseSet, int ySetSize, int zSetSize, const float* pieceSet, int zPieceSize,
+	const ChunkAxisPiece& x, const ChunkAxisPiece& y, int zPieceOffset, int zOffset, int zSize)
+{
+	const float* row = pieceSet + zPieceOffset;
+
+	for (int ix = 0; ix < x.size; ix++)
+	{
+		for (int iy = 0; iy < y.size; iy++)
+		{
+			std::memcpy(noiseSet + ((x.offset + ix) * ySetSize + y.offset + iy) * zSetSize + zOffset,
+				row, zSize * sizeof(float));
+
+			row += zPieceSize;
+		}
+	}
+}
+
+void FastNoiseChunkGrid::FillChunk(float* noiseSet, int xChunk, int yChunk, int zChunk)
+{
+	assert(noiseSet);
+
+	ChunkAxisPiece xPieces[3], yPieces[3], zPieces[3];
+	ChunkAxisPieces(xPieces, xChunk, m_xChunkSize, m_apron);
+	ChunkAxisPieces(yPieces, yChunk, m_yChunkSize, m_apron);
+	ChunkAxisPieces(zPieces, zChunk, m_zChunkSize, m_apron);
+
+	int ySetSize = GetYSetSize();
+	int zSetSize = GetZSetSize();
+
+	for (const ChunkAxisPiece& x : xPieces)
+	{
+		for (const ChunkAxisPiece& y : yPieces)
+		{
+			if (x.size == 0 || y.size == 0)
+				continue;
+
+			// Faces are shared by 2 chunks, edges by 4 and corners by 8
+			int borderUses[3];
+			std::map<std::tuple<int, int, int>, BorderSlab>::iterator cached[3];
+
+			for (int iz = 0; iz < 3; iz++)
+			{
+				int borderAxes = x.border + y.border + zPieces[iz].border;
+
+				borderUses[iz] = borderAxes ? 1 << borderAxes : 0;
+				cached[iz] = m_borderCache.end();
+
+				if (borderUses[iz] && zPieces[iz].size)
+					cached[iz] = m_borderCache.find(std::make_tuple(x.key, y.key, zPieces[iz].key));
+			}
+
+			// Runs of uncached z pieces are generated together so thin border slabs still fill whole vectors
+			for (int iz = 0; iz < 3; iz++)
+			{
+				if (cached[iz] != m_borderCache.end() || zPieces[iz].size == 0)
+					continue;
+
+				int runEnd = iz;
+				int zRunSize = 0;
+
+				while (runEnd < 3 && cached[runEnd] == m_borderCache.end())
+					zRunSize += zPieces[runEnd++].size;
+
+				float* pieceSet = FastNoiseSIMD::GetEmptySet(x.size, y.size, zRunSize);
+				m_noise->FillLinearNoiseSet(pieceSet, x.start, y.start, zPieces[iz].start, x.size, y.size, zRunSize, m_scaleModifier);
+				ChunkCopyPiece(noiseSet, ySetSize, zSetSize, pieceSet, zRunSize, x, y, 0, zPieces[iz].offset, zRunSize);
+
+				int zPieceOffset = 0;
+
+				for (; iz < runEnd; iz++)
+				{
+					const ChunkAxisPiece& z = zPieces[iz];
+
+					if (borderUses[iz] && z.size)
+					{
+						float* slabSet = FastNoiseSIMD::GetEmptySet(x.size, y.size, z.size);
+						const float* row = pieceSet + zPieceOffset;
+
+						for (int i = 0; i < x.size * y.size; i++)
+						{
+							std::memcpy(slabSet + i * z.size, row, z.size * sizeof(float));
+							row += zRunSize;
+						}
+
+						m_borderCache.insert(std::make_pair(std::make_tuple(x.key, y.key, z.key), BorderSlab{ slabSet, borderUses[iz] - 1 }));
+					}
+
+					zPieceOffset += z.size;
+				}
+
+				iz--;
+				FastNoiseSIMD::FreeNoiseSet(pieceSet);
+			}
+
+			for (int iz = 0; iz < 3; iz++)
+			{
+				if (cached[iz] == m_borderCache.end())
+					continue;
+
+				BorderSlab& slab = cached[iz]->second;
+				ChunkCopyPiece(noiseSet, ySetSize, zSetSize, slab.noiseSet, zPieces[iz].size, x, y, 0, zPieces[iz].offset, zPieces[iz].size);
+
+				if (--slab.remainingUses == 0)
+				{
+					FastNoiseSIMD::FreeNoiseSet(slab.noiseSet);
+					m_borderCache.erase(cached[iz]);
+				}
+			}
+		}
+	}
+}
@@ -93,7 +93,12 @@ Intel Haswell - Q2 2013
 AMD Piledriver - 2012
 */
 
+#include <map>
+#include <tuple>
+
 struct FastNoiseVectorSet;
+class FastNoiseRingVolume;
+class FastNoiseChunkGrid;
 
 class FastNoiseSIMD
 {
@@ -106,6 +111,8 @@ public:
 	enum CellularDistanceFunction { Euclidean, Manhattan, Natural };
 	enum CellularReturnType { CellValue, Distance, Distance2, Distance2Add, Distance2Sub, Distance2Mul, Distance2Div, NoiseLookup, Distance2Cave };
 
+	enum OutputLayout { Linear, Morton, Brick };
+
 	// Creates new FastNoiseSIMD for the highest supported instuction set of the CPU 
 	static FastNoiseSIMD* NewFastNoiseSIMD(int seed = 1337);
 
@@ -136,6 +143,9 @@ public:
 	// Create an empty (aligned) noise set for use with FillNoiseSet()
 	static float* GetEmptySet(int size);
 
+	// Returns the position of (x, y, z) in a noise set of the given size and layout
+	static int GetLayoutIndex(OutputLayout layout, int x, int y, int z, int xSize, int ySize, int zSize);
+
 	// Create an empty (aligned) noise set for use with FillNoiseSet()
 	static float* GetEmptySet(int xSize, int ySize, int zSize) { return GetEmptySet(xSize*ySize*zSize); }
 
@@ -238,6 +248,22 @@ public:
 	void SetPerturbNormaliseLength(float perturbNormaliseLength) { m_perturbNormaliseLength = perturbNormaliseLength; }
 
 
+	// Sets the largest per sample step, in noise input space, at which a fractal octave is up-sampled
+	// from the next coarser level in (Get/Fill)NoisePyramid() instead of being evaluated directly
+	// Lower values increase accuracy, higher values increase speed
+	// Billow and RigidMulti octaves have creases so they up-sample less accurately than FBM
+	// Default: 0.0625
+	void SetPyramidUpsampleStep(float pyramidUpsampleStep) { m_pyramidUpsampleStep = pyramidUpsampleStep; }
+
+
+	// Sets the memory order of sets from (Get/Fill)NoiseSet(), use GetLayoutIndex() to address them
+	// Linear: x major, z minor
+	// Morton: Z-order curve with z as the lowest bit, all set sizes must be the same power of 2
+	// Brick: 8x8x8 linear bricks stored in linear order, set sizes must be multiples of 8
+	// Default: Linear
+	void SetOutputLayout(OutputLayout outputLayout) { m_outputLayout = outputLayout; }
+
+
 	static FastNoiseVectorSet* GetVectorSet(int xSize, int ySize, int zSize);
 	static FastNoiseVectorSet* GetSamplingVectorSet(int sampleScale, int xSize, int ySize, int zSize);
 	static void FillVectorSet(FastNoiseVectorSet* vectorSet, int xSize, int ySize, int zSize);
@@ -247,6 +273,46 @@ public:
 	void FillNoiseSet(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier = 1.0f);
 	void FillNoiseSet(float* noiseSet, FastNoiseVectorSet* vectorSet, float xOffset = 0.0f, float yOffset = 0.0f, float zOffset = 0.0f);
 
+	// Multi-threaded (Get/Fill)NoiseSet(), each worker generates a slab along the x axis
+	// threadCount 0 uses one worker per hardware thread
+	// Slabs start on whole SIMD vectors, so small sets may use fewer workers than requested
+	// Workers are pinned to NUMA nodes and are the first to touch their slab, so its pages are placed on their node
+	// The set is not allocated per node, pages that were touched before the fill stay where they are
+	// FillNoiseSetParallel() expects a set that has not been written to, GetEmptySet() does not touch memory
+	// Morton layout sets are filled on the calling thread
+	float* GetNoiseSetParallel(int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier = 1.0f, int threadCount = 0);
+	void FillNoiseSetParallel(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier = 1.0f, int threadCount = 0);
+
+	// Sets the NUMA node parallel fill workers are pinned to
+	// -1: Workers and their slabs are split evenly over all nodes in x order
+	// n: All workers are pinned to node n
+	// Pinning is currently only supported on Linux
+	// Default: -1
+	void SetParallelNumaNode(int numaNode) { m_parallelNumaNode = numaNode; }
+
+	// Returns the number of NUMA nodes in the system, 1 if unknown
+	static int GetNumaNodeCount(void);
+
+	// Returns the NUMA node that (Get/Fill)NoiseSetParallel() places the data for xIndex on
+	int GetParallelNumaNode(int xIndex, int xSize, int ySize, int zSize, int threadCount = 0) const;
+
+	// Level of detail pyramid for clipmap style terrain, noiseSets[0] is the finest level
+	// Every level has the same set size and double the sample spacing of the level before it
+	// Level i is centred on (xCentre >> i, yCentre >> i, zCentre >> i) in its own sample space
+	// Fractal octaves that are smooth at a coarser level's sample spacing are only evaluated on
+	// that level and trilinearly up-sampled into the finer levels
+	// With perturbation every level is filled directly, the result is then the same as FillNoiseSet()
+	float** GetNoisePyramid(int levelCount, int xCentre, int yCentre, int zCentre, int xSize, int ySize, int zSize, float scaleModifier = 1.0f);
+	void FillNoisePyramid(float** noiseSets, int levelCount, int xCentre, int yCentre, int zCentre, int xSize, int ySize, int zSize, float scaleModifier = 1.0f);
+
+	// Free a noise pyramid from GetNoisePyramid() from memory
+	static void FreeNoisePyramid(float** noiseSets, int levelCount);
+
+	// Fills the sum of fractal octaves [octaveStart, octaveEnd) for the current fractal noise type
+	// Adding together the sets for adjacent octave ranges gives the same result as FillNoiseSet()
+	// Non fractal noise types are treated as having a single octave
+	virtual void FillFractalOctaveSet(float* noiseSet, int octaveStart, int octaveEnd, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier = 1.0f) = 0;
+
 	float* GetSampledNoiseSet(int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, int sampleScale);
 	virtual void FillSampledNoiseSet(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, int sampleScale) = 0;
 	virtual void FillSampledNoiseSet(float* noiseSet, FastNoiseVectorSet* vectorSet, float xOffset = 0.0f, float yOffset = 0.0f, float zOffset = 0.0f) = 0;
@@ -322,8 +388,25 @@ protected:
 	float m_perturbFractalBounding;
 	float m_perturbNormaliseLength = 1.0f;
 
+	float m_pyramidUpsampleStep = 0.0625f;
+
+	OutputLayout m_outputLayout = Linear;
+
+	int m_parallelNumaNode = -1;
+
 	static int s_currentSIMDLevel;
 	static float CalculateFractalBounding(int octaves, float gain);
+	int PyramidSharedOctaves(int level, float scaleModifier) const;
+
+	friend class FastNoiseRingVolume;
+	friend class FastNoiseChunkGrid;
+
+	// Splits xSize into per worker slabs for FillNoiseSetParallel(), returns the worker count
+	int ParallelSlabs(int* slabStarts, int xSize, int ySize, int zSize, int threadCount) const;
+	int ParallelWorkerNode(int worker, int workerCount) const;
+
+	// FillNoiseSet() ignoring the output layout
+	void FillLinearNoiseSet(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier = 1.0f);
 };
 
 struct FastNoiseVectorSet
@@ -351,6 +434,106 @@ public:
 	void SetSize(int _size);
 };
 
+// Noise volume stored as a ring buffer that follows a moving window
+// Moving the window only generates the newly exposed slabs, everything else stays in place
+// World position (x, y, z) is always stored at Index(x, y, z), data is x major like noise sets
+// Call Refresh() after changing settings on the FastNoiseSIMD object
+class FastNoiseRingVolume
+{
+public:
+	FastNoiseRingVolume(FastNoiseSIMD* noise, int xSize, int ySize, int zSize, float scaleModifier = 1.0f);
+	~FastNoiseRingVolume();
+
+	FastNoiseRingVolume(const FastNoiseRingVolume&) = delete;
+	FastNoiseRingVolume& operator=(const FastNoiseRingVolume&) = delete;
+
+	// Moves the minimum corner of the window to the given world position
+	// Only slabs not covered by the previous window are generated
+	void SetOrigin(int xOrigin, int yOrigin, int zOrigin);
+
+	// Moves the window relative to its current position
+	void Move(int xDelta, int yDelta, int zDelta) { SetOrigin(m_xOrigin + xDelta, m_yOrigin + yDelta, m_zOrigin + zDelta); }
+
+	// Regenerates the whole window
+	void Refresh();
+
+	int GetXOrigin(void) const { return m_xOrigin; }
+	int GetYOrigin(void) const { return m_yOrigin; }
+	int GetZOrigin(void) const { return m_zOrigin; }
+
+	int GetXSize(void) const { return m_xSize; }
+	int GetYSize(void) const { return m_ySize; }
+	int GetZSize(void) const { return m_zSize; }
+
+	// Toroidal buffer index of a world position, only valid inside the current window
+	int Index(int x, int y, int z) const { return Wrap(x, m_xSize) * m_ySize * m_zSize + Wrap(y, m_ySize) * m_zSize + Wrap(z, m_zSize); }
+
+	// Returns the noise value at a world position inside the current window
+	float GetValue(int x, int y, int z) const { return m_data[Index(x, y, z)]; }
+
+	// Raw ring buffer, use Index() to address it
+	const float* GetData(void) const { return m_data; }
+
+private:
+	FastNoiseSIMD* m_noise;
+	float* m_data;
+	float m_scaleModifier;
+
+	int m_xSize, m_ySize, m_zSize;
+	int m_xOrigin = 0;
+	int m_yOrigin = 0;
+	int m_zOrigin = 0;
+
+	static int Wrap(int i, int size) { i %= size; return i < 0 ? i + size : i; }
+
+	// Generates a world space box, must lie inside the current window
+	void FillRegion(int xStart, int yStart, int zStart, int xSize, int ySize, int zSize);
+};
+
+// Generates a grid of chunks that each carry an apron of voxels from their neighbours
+// Each chunk axis is split into shared border slabs (2 * apron wide) and an unshared core
+// Border faces, edges and corners are generated once and cached until every chunk sharing them has been filled
+// Call ClearCache() after changing settings on the FastNoiseSIMD object
+class FastNoiseChunkGrid
+{
+public:
+	// Chunk sizes exclude the apron and must be larger than 2 * apron
+	FastNoiseChunkGrid(FastNoiseSIMD* noise, int xChunkSize, int yChunkSize, int zChunkSize, int apron = 1, float scaleModifier = 1.0f);
+	~FastNoiseChunkGrid() { ClearCache(); }
+
+	FastNoiseChunkGrid(const FastNoiseChunkGrid&) = delete;
+	FastNoiseChunkGrid& operator=(const FastNoiseChunkGrid&) = delete;
+
+	// Returns a noise set of (size + 2 * apron) on each axis starting at world position chunk * size - apron
+	// Free with FastNoiseSIMD::FreeNoiseSet()
+	float* GetChunk(int xChunk, int yChunk, int zChunk);
+	void FillChunk(float* noiseSet, int xChunk, int yChunk, int zChunk);
+
+	// Frees all cached border slabs
+	void ClearCache();
+
+	// Number of border slabs waiting on a neighbouring chunk
+	int GetCachedSlabCount(void) const { return (int)m_borderCache.size(); }
+
+	int GetXSetSize(void) const { return m_xChunkSize + m_apron * 2; }
+	int GetYSetSize(void) const { return m_yChunkSize + m_apron * 2; }
+	int GetZSetSize(void) const { return m_zChunkSize + m_apron * 2; }
+
+private:
+	struct BorderSlab
+	{
+		float* noiseSet;
+		int remainingUses;
+	};
+
+	FastNoiseSIMD* m_noise;
+	float m_scaleModifier;
+	int m_xChunkSize, m_yChunkSize, m_zChunkSize;
+	int m_apron;
+
+	std::map<std::tuple<int, int, int>, BorderSlab> m_borderCache;
+};
+
 #define FN_CELLULAR_INDEX_MAX 3
 
 #define FN_NO_SIMD_FALLBACK 0
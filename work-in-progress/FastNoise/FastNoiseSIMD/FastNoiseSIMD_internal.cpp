@@ -1312,6 +1312,75 @@ else\
 		result = SIMDf_NMUL_ADD(SIMDf_SUB(SIMDf_NUM(1), SIMDf_ABS(FUNC(f##Single)(seedF, xF, yF, zF))), ampF, result);\
 	}
 
+// FBM OCTAVE RANGE
+#define FBM_OCTAVE_SINGLE(f)\
+	SIMDi seedF = octaveSeedV;\
+	xF = SIMDf_MUL(xF, octaveFreqV);\
+	yF = SIMDf_MUL(yF, octaveFreqV);\
+	zF = SIMDf_MUL(zF, octaveFreqV);\
+	\
+	SIMDf ampF = octaveAmpV;\
+	result = SIMDf_MUL(FUNC(f##Single)(seedF, xF, yF, zF), ampF);\
+	int octaveIndex = octaveStart;\
+	\
+	while (++octaveIndex < octaveEnd)\
+	{\
+		xF = SIMDf_MUL(xF, lacunarityV);\
+		yF = SIMDf_MUL(yF, lacunarityV);\
+		zF = SIMDf_MUL(zF, lacunarityV);\
+		seedF = SIMDi_ADD(seedF, SIMDi_NUM(1));\
+		\
+		ampF = SIMDf_MUL(ampF, gainV);\
+		result = SIMDf_MUL_ADD(FUNC(f##Single)(seedF, xF, yF, zF), ampF, result);\
+	}\
+	result = SIMDf_MUL(result, fractalBoundingV)
+
+// BILLOW OCTAVE RANGE
+#define BILLOW_OCTAVE_SINGLE(f)\
+	SIMDi seedF = octaveSeedV;\
+	xF = SIMDf_MUL(xF, octaveFreqV);\
+	yF = SIMDf_MUL(yF, octaveFreqV);\
+	zF = SIMDf_MUL(zF, octaveFreqV);\
+	\
+	SIMDf ampF = octaveAmpV;\
+	result = SIMDf_MUL(SIMDf_MUL_SUB(SIMDf_ABS(FUNC(f##Single)(seedF, xF, yF, zF)), SIMDf_NUM(2), SIMDf_NUM(1)), ampF);\
+	int octaveIndex = octaveStart;\
+	\
+	while (++octaveIndex < octaveEnd)\
+	{\
+		xF = SIMDf_MUL(xF, lacunarityV);\
+		yF = SIMDf_MUL(yF, lacunarityV);\
+		zF = SIMDf_MUL(zF, lacunarityV);\
+		seedF = SIMDi_ADD(seedF, SIMDi_NUM(1));\
+		\
+		ampF = SIMDf_MUL(ampF, gainV);\
+		result = SIMDf_MUL_ADD(SIMDf_MUL_SUB(SIMDf_ABS(FUNC(f##Single)(seedF, xF, yF, zF)), SIMDf_NUM(2), SIMDf_NUM(1)), ampF, result);\
+	}\
+	result = SIMDf_MUL(result, fractalBoundingV)
+
+// RIGIDMULTI OCTAVE RANGE
+// Only octave 0 is added, every following octave is subtracted
+#define RIGIDMULTI_OCTAVE_SINGLE(f)\
+	SIMDi seedF = octaveSeedV;\
+	xF = SIMDf_MUL(xF, octaveFreqV);\
+	yF = SIMDf_MUL(yF, octaveFreqV);\
+	zF = SIMDf_MUL(zF, octaveFreqV);\
+	\
+	SIMDf ampF = octaveAmpV;\
+	result = SIMDf_MUL(SIMDf_SUB(SIMDf_NUM(1), SIMDf_ABS(FUNC(f##Single)(seedF, xF, yF, zF))), rigidFirstAmpV);\
+	int octaveIndex = octaveStart;\
+	\
+	while (++octaveIndex < octaveEnd)\
+	{\
+		xF = SIMDf_MUL(xF, lacunarityV);\
+		yF = SIMDf_MUL(yF, lacunarityV);\
+		zF = SIMDf_MUL(zF, lacunarityV);\
+		seedF = SIMDi_ADD(seedF, SIMDi_NUM(1));\
+		\
+		ampF = SIMDf_MUL(ampF, gainV);\
+		result = SIMDf_NMUL_ADD(SIMDf_SUB(SIMDf_NUM(1), SIMDf_ABS(FUNC(f##Single)(seedF, xF, yF, zF))), ampF, result);\
+	}
+
 #define FILL_SET(func) \
 void SIMD_LEVEL_CLASS::Fill##func##Set(float* noiseSet, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier)\
 {\
@@ -1378,6 +1447,87 @@ FILL_FRACTAL_SET(Simplex)
 FILL_SET(Cubic)
 FILL_FRACTAL_SET(Cubic)
 
+#define FRACTAL_OCTAVE_MULTI(func)\
+switch(m_fractalType)\
+{\
+case FBM:\
+	SET_BUILDER(FBM_OCTAVE_SINGLE(func))\
+	break;\
+case Billow:\
+	SET_BUILDER(BILLOW_OCTAVE_SINGLE(func))\
+	break;\
+case RigidMulti:\
+	SET_BUILDER(RIGIDMULTI_OCTAVE_SINGLE(func))\
+	break;\
+}
+
+void SIMD_LEVEL_CLASS::FillFractalOctaveSet(float* noiseSet, int octaveStart, int octaveEnd, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize, float scaleModifier)
+{
+	assert(noiseSet);
+
+	bool fractal = m_noiseType == ValueFractal || m_noiseType == PerlinFractal || m_noiseType == SimplexFractal || m_noiseType == CubicFractal;
+
+	if (!fractal && octaveStart <= 0 && octaveEnd > 0)
+	{
+		FillLinearNoiseSet(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize, scaleModifier);
+		return;
+	}
+
+	if (!fractal || octaveStart >= octaveEnd)
+	{
+		int size = xSize * ySize * zSize;
+		for (int i = 0; i < size; i++)
+			noiseSet[i] = 0.0f;
+		return;
+	}
+
+	SIMD_ZERO_ALL();
+
+	SIMDi seedV = SIMDi_SET(m_seed);
+	SIMDf lacunarityV = SIMDf_SET(m_lacunarity);
+	SIMDf gainV = SIMDf_SET(m_gain);
+	SIMDf fractalBoundingV = SIMDf_SET(m_fractalBounding);
+	INIT_PERTURB_VALUES();
+
+	float octaveFreq = 1.0f;
+	float octaveAmp = 1.0f;
+	for (int i = 0; i < octaveStart; i++)
+	{
+		octaveFreq *= m_lacunarity;
+		octaveAmp *= m_gain;
+	}
+
+	SIMDi octaveSeedV = SIMDi_SET(m_seed + octaveStart);
+	SIMDf octaveFreqV = SIMDf_SET(octaveFreq);
+	SIMDf octaveAmpV = SIMDf_SET(octaveAmp);
+	SIMDf rigidFirstAmpV = SIMDf_SET(octaveStart == 0 ? octaveAmp : -octaveAmp);
+
+	scaleModifier *= m_frequency;
+
+	SIMDf xFreqV = SIMDf_SET(scaleModifier * m_xScale);
+	SIMDf yFreqV = SIMDf_SET(scaleModifier * m_yScale);
+	SIMDf zFreqV = SIMDf_SET(scaleModifier * m_zScale);
+
+	switch (m_noiseType)
+	{
+	case ValueFractal:
+		FRACTAL_OCTAVE_MULTI(Value)
+		break;
+	case PerlinFractal:
+		FRACTAL_OCTAVE_MULTI(Perlin)
+		break;
+	case SimplexFractal:
+		FRACTAL_OCTAVE_MULTI(Simplex)
+		break;
+	case CubicFractal:
+		FRACTAL_OCTAVE_MULTI(Cubic)
+		break;
+	default:
+		break;
+	}
+	SIMD_ZERO_ALL();
+}
+
 #ifdef FN_ALIGNED_SETS
 #define SIZE_MASK
 #define SAFE_LAST(f)
@@ -2137,7 +2287,7 @@ void SIMD_LEVEL_CLASS::FillSampledNoiseSet(float* noiseSet, int xStart, int ySta
 
 	if (sampleScale <= 0)
 	{
-		FillNoiseSet(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize);
+		FillLinearNoiseSet(noiseSet, xStart, yStart, zStart, xSize, ySize, zSize);
 		return;
 	}
 
@@ -2167,7 +2317,7 @@ void SIMD_LEVEL_CLASS::FillSampledNoiseSet(float* noiseSet, int xStart, int ySta
 	zSizeSample = (zSizeSample >> sampleScale) + 1;
 
 	float* noiseSetSample = GetEmptySet(xSizeSample * ySizeSample * zSizeSample);
-	FillNoiseSet(noiseSetSample, xStart >> sampleScale, yStart >> sampleScale, zStart >> sampleScale, xSizeSample, ySizeSample, zSizeSample, scaleModifier);
+	FillLinearNoiseSet(noiseSetSample, xStart >> sampleScale, yStart >> sampleScale, zStart >> sampleScale, xSizeSample, ySizeSample, zSizeSample, scaleModifier);
 
 	int yzSizeSample = ySizeSample * zSizeSample;
 	int yzSize = ySize * zSize;
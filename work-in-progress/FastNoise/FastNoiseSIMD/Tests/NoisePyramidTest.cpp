@@ -0,0 +1,119 @@
+// NoisePyramidTest.cpp
+//
+// Checks every level of FillNoisePyramid() against FillNoiseSet() with the
+// level's own start and scale, for all fractal noise and fractal types, with
+// and without perturbation. Also checks that FillFractalOctaveSet() for two
+// adjacent octave ranges adds up to FillNoiseSet(), which the up-sampled
+// pyramid levels are built from. Returns 0 if everything is within tolerance
+//
+// g++ -O2 -I.. NoisePyramidTest.cpp ../FastNoiseSIMD*.cpp (each SIMD file with its -m flags)
+//
+
+#include "FastNoiseSIMD.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+// Largest difference between a pyramid level and FillNoiseSet() over all levels
+static float PyramidMaxError(FastNoiseSIMD* noise, int levelCount, int xCentre, int yCentre, int zCentre, int size, float scaleModifier)
+{
+	float** pyramid = noise->GetNoisePyramid(levelCount, xCentre, yCentre, zCentre, size, size, size, scaleModifier);
+	float* direct = FastNoiseSIMD::GetEmptySet(size, size, size);
+	float maxError = 0.0f;
+
+	for (int level = 0; level < levelCount; level++)
+	{
+		noise->FillNoiseSet(direct, (xCentre >> level) - size / 2, (yCentre >> level) - size / 2, (zCentre >> level) - size / 2,
+			size, size, size, scaleModifier * float(1 << level));
+
+		for (int i = 0; i < size * size * size; i++)
+			maxError = std::max(maxError, std::abs(direct[i] - pyramid[level][i]));
+	}
+
+	FastNoiseSIMD::FreeNoiseSet(direct);
+	FastNoiseSIMD::FreeNoisePyramid(pyramid, levelCount);
+	return maxError;
+}
+
+// Largest difference between FillNoiseSet() and the sum of FillFractalOctaveSet() for octaves
+// [0, split) and [split, octaves) over all splits, relative to the larger of 1 and the value
+static float OctaveSplitMaxError(FastNoiseSIMD* noise, int octaves, int xStart, int yStart, int zStart, int size, float scaleModifier)
+{
+	float* full = FastNoiseSIMD::GetEmptySet(size, size, size);
+	float* low = FastNoiseSIMD::GetEmptySet(size, size, size);
+	float* high = FastNoiseSIMD::GetEmptySet(size, size, size);
+	float maxError = 0.0f;
+
+	noise->FillNoiseSet(full, xStart, yStart, zStart, size, size, size, scaleModifier);
+
+	for (int split = 1; split < octaves; split++)
+	{
+		noise->FillFractalOctaveSet(low, 0, split, xStart, yStart, zStart, size, size, size, scaleModifier);
+		noise->FillFractalOctaveSet(high, split, octaves, xStart, yStart, zStart, size, size, size, scaleModifier);
+
+		for (int i = 0; i < size * size * size; i++)
+			maxError = std::max(maxError, std::abs(full[i] - (low[i] + high[i])) / std::max(1.0f, std::abs(full[i])));
+	}
+
+	FastNoiseSIMD::FreeNoiseSet(full);
+	FastNoiseSIMD::FreeNoiseSet(low);
+	FastNoiseSIMD::FreeNoiseSet(high);
+	return maxError;
+}
+
+int main()
+{
+	const FastNoiseSIMD::NoiseType noiseTypes[] = { FastNoiseSIMD::ValueFractal, FastNoiseSIMD::PerlinFractal, FastNoiseSIMD::SimplexFractal, FastNoiseSIMD::CubicFractal };
+	const FastNoiseSIMD::FractalType fractalTypes[] = { FastNoiseSIMD::FBM, FastNoiseSIMD::Billow, FastNoiseSIMD::RigidMulti };
+	const FastNoiseSIMD::PerturbType perturbTypes[] = { FastNoiseSIMD::None, FastNoiseSIMD::Gradient, FastNoiseSIMD::GradientFractal };
+	const char* noiseNames[] = { "ValueFractal", "PerlinFractal", "SimplexFractal", "CubicFractal" };
+	const char* fractalNames[] = { "FBM", "Billow", "RigidMulti" };
+	const char* perturbNames[] = { "None", "Gradient", "GradientFractal" };
+
+	// Up-sampled octaves differ from directly evaluated ones by the trilinear error, which is
+	// bigger for Billow and RigidMulti because they fold each octave with abs().
+	// Everything else must match up to float rounding
+	const float upsampleTolerances[] = { 0.005f, 0.06f, 0.06f };
+	const float exactTolerance = 1e-4f;
+	const float splitTolerance = 2 * FLT_EPSILON;
+
+	const int octaves = 6;
+	FastNoiseSIMD* noise = FastNoiseSIMD::NewFastNoiseSIMD(1337);
+	noise->SetFractalOctaves(octaves);
+	int failures = 0;
+
+	printf("SIMD level %d\n", FastNoiseSIMD::GetSIMDLevel());
+	printf("%-15s %-11s %-16s %10s %10s %10s\n", "Noise", "Fractal", "Perturb", "step 1/16", "step 0", "split/eps");
+
+	for (int n = 0; n < 4; n++)
+	{
+		for (int f = 0; f < 3; f++)
+		{
+			for (int p = 0; p < 3; p++)
+			{
+				noise->SetNoiseType(noiseTypes[n]);
+				noise->SetFractalType(fractalTypes[f]);
+				noise->SetPerturbType(perturbTypes[p]);
+
+				noise->SetPyramidUpsampleStep(0.0625f);
+				float upsampleError = PyramidMaxError(noise, 4, 1000, -37, 512, 32, 0.25f);
+				noise->SetPyramidUpsampleStep(0.0f);
+				float exactError = PyramidMaxError(noise, 4, 1000, -37, 512, 32, 0.25f);
+				float splitError = OctaveSplitMaxError(noise, octaves, 1000, -37, 512, 32, 0.25f);
+
+				bool fail = upsampleError > (p == 0 ? upsampleTolerances[f] : exactTolerance) || exactError > exactTolerance ||
+					splitError > splitTolerance;
+				failures += fail;
+
+				printf("%-15s %-11s %-16s %10.6f %10.6f %10.2f%s\n", noiseNames[n], fractalNames[f], perturbNames[p],
+					upsampleError, exactError, splitError / FLT_EPSILON, fail ? "  FAIL" : "");
+			}
+		}
+	}
+
+	delete noise;
+
+	printf(failures ? "%d FAILED\n" : "All passed\n", failures);
+	return failures ? 1 : 0;
+}
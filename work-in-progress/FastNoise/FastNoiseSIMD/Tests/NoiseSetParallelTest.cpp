@@ -0,0 +1,66 @@
+// NoiseSetParallelTest.cpp
+//
+// Checks GetNoiseSetParallel() against GetNoiseSet() for set sizes that are
+// and are not multiples of the SIMD vector size, with several thread counts
+// and output layouts. Returns 0 if every set is identical
+//
+// g++ -O2 -I.. NoiseSetParallelTest.cpp ../FastNoiseSIMD*.cpp -lpthread (each SIMD file with its -m flags)
+//
+
+#include "FastNoiseSIMD.h"
+#include <cstdio>
+#include <cstring>
+
+// Number of values that differ between the parallel and the serial set
+static int ParallelMismatches(FastNoiseSIMD* noise, int xSize, int ySize, int zSize, int threadCount)
+{
+	float* serial = noise->GetNoiseSet(-7, 3, 11, xSize, ySize, zSize);
+	float* parallel = noise->GetNoiseSetParallel(-7, 3, 11, xSize, ySize, zSize, 1.0f, threadCount);
+	int mismatches = 0;
+
+	for (int i = 0; i < xSize * ySize * zSize; i++)
+		mismatches += memcmp(&serial[i], &parallel[i], sizeof(float)) != 0;
+
+	FastNoiseSIMD::FreeNoiseSet(serial);
+	FastNoiseSIMD::FreeNoiseSet(parallel);
+	return mismatches;
+}
+
+int main()
+{
+	const int sizes[][3] = { { 30, 30, 30 }, { 50, 50, 50 }, { 32, 32, 32 }, { 33, 7, 5 }, { 17, 1, 1 }, { 64, 3, 9 } };
+	const int threadCounts[] = { 1, 2, 3, 4, 7 };
+	int failures = 0;
+
+	FastNoiseSIMD* noise = FastNoiseSIMD::NewFastNoiseSIMD(1337);
+	noise->SetNoiseType(FastNoiseSIMD::SimplexFractal);
+
+	printf("SIMD level %d\n", FastNoiseSIMD::GetSIMDLevel());
+
+	for (const int* size : sizes)
+	{
+		for (int threadCount : threadCounts)
+		{
+			int mismatches = ParallelMismatches(noise, size[0], size[1], size[2], threadCount);
+			failures += mismatches != 0;
+
+			printf("Linear %2dx%2dx%2d %d threads: %d mismatches%s\n", size[0], size[1], size[2], threadCount,
+				mismatches, mismatches ? "  FAIL" : "");
+		}
+	}
+
+	// Brick slabs are whole bricks
+	noise->SetOutputLayout(FastNoiseSIMD::Brick);
+	for (int threadCount : threadCounts)
+	{
+		int mismatches = ParallelMismatches(noise, 40, 16, 24, threadCount);
+		failures += mismatches != 0;
+
+		printf("Brick  40x16x24 %d threads: %d mismatches%s\n", threadCount, mismatches, mismatches ? "  FAIL" : "");
+	}
+
+	delete noise;
+
+	printf(failures ? "%d FAILED\n" : "All passed\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+// SharedScaling.cpp
+//
+// Thread scaling of one immutable FastNoise::Shared configuration from
+// FastNoise::Builder, sampled concurrently by 1 to 32 threads. Each thread
+// gets an equal slice of a fixed number of points, so with perfect scaling
+// the time halves every time the thread count doubles. A private copy of the
+// noise per thread is timed alongside as the reference without any sharing
+//
+// g++ -O2 -std=c++11 -I.. SharedScaling.cpp ../FastNoise.cpp -lpthread
+// Usage: SharedScaling [max threads, default 32] [points, default 16777216]
+//
+
+#include "FastNoise.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Samples points [begin, end) of a 256 x 256 x n grid, returns the sum to keep the work alive
+static float SampleRange(const FastNoise& noise, int begin, int end)
+{
+	float sum = 0.0f;
+
+	for (int i = begin; i < end; i++)
+		sum += noise.GetNoise(FN_DECIMAL(i & 255), FN_DECIMAL((i >> 8) & 255), FN_DECIMAL(i >> 16));
+
+	return sum;
+}
+
+// Returns seconds to sample all points with threadCount threads
+// shared: every thread reads the same instance, otherwise each thread samples its own copy
+static double TimeThreads(const FastNoise::Shared& noise, int threadCount, int points, bool shared)
+{
+	std::vector<std::thread> threads;
+	std::vector<float> sums(threadCount);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&, t]()
+		{
+			int begin = int((long long)points * t / threadCount);
+			int end = int((long long)points * (t + 1) / threadCount);
+
+			if (shared)
+			{
+				sums[t] = SampleRange(*noise, begin, end);
+			}
+			else
+			{
+				FastNoise copy(*noise);
+				sums[t] = SampleRange(copy, begin, end);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? atoi(argv[1]) : 32;
+	int points = argc > 2 ? atoi(argv[2]) : 1 << 24;
+
+	FastNoise::Shared noise = FastNoise::Builder(1337)
+		.SetNoiseType(FastNoise::SimplexFractal)
+		.SetFractalOctaves(3)
+		.SetFrequency(FN_DECIMAL(0.02))
+		.Build();
+
+	printf("%d points of 3D SimplexFractal, %u hardware threads\n", points, std::thread::hardware_concurrency());
+	printf("%8s %12s %12s %10s %10s\n", "threads", "shared ms", "private ms", "speedup", "Mpoints/s");
+
+	double oneThread = 0.0;
+
+	for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		double sharedTime = TimeThreads(noise, threadCount, points, true);
+		double privateTime = TimeThreads(noise, threadCount, points, false);
+
+		if (threadCount == 1)
+			oneThread = sharedTime;
+
+		printf("%8d %12.1f %12.1f %10.2f %10.1f\n", threadCount, sharedTime * 1e3, privateTime * 1e3,
+			oneThread / sharedTime, points / sharedTime * 1e-6);
+	}
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+// ShortLivedSeeds.cpp
+//
+// Cost of creating many short lived FastNoise instances one after the other,
+// each sampling a few points before it is destroyed. The seeds cycle through
+// a small set, so the permutation tables can be reused from the seed cache.
+// A run with a new seed for every instance is timed alongside as the cost of
+// building every table
+//
+// g++ -O2 -std=c++11 -I.. ShortLivedSeeds.cpp ../FastNoise.cpp -lpthread
+// Usage: ShortLivedSeeds [instances, default 200000] [seeds, default 5]
+//
+
+#include "FastNoise.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Returns seconds to create, sample and destroy instances one at a time, the seed of instance i is seeds[i % seedCount]
+// seedCount 0 gives every instance its own seed
+static double TimeInstances(int instances, int seedCount, float& sum)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < instances; i++)
+	{
+		FastNoise noise(seedCount ? 1000 + i % seedCount : i);
+		noise.SetNoiseType(FastNoise::Simplex);
+
+		for (int k = 0; k < 4; k++)
+			sum += noise.GetNoise(FN_DECIMAL(i), FN_DECIMAL(k), FN_DECIMAL(0.5));
+	}
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	int instances = argc > 1 ? atoi(argv[1]) : 200000;
+	int seedCount = argc > 2 ? atoi(argv[2]) : 5;
+	float sum = 0.0f;
+
+	double reused = TimeInstances(instances, seedCount, sum);
+	double unique = TimeInstances(instances, 0, sum);
+
+	printf("%d short lived instances, 4 samples each\n", instances);
+	printf("%-16s %10s %14s\n", "seeds", "ms", "ns/instance");
+	printf("%-16d %10.1f %14.1f\n", seedCount, reused * 1e3, reused * 1e9 / instances);
+	printf("%-16s %10.1f %14.1f\n", "one per instance", unique * 1e3, unique * 1e9 / instances);
+	printf("(checksum %g)\n", sum);
+
+	return 0;
+}
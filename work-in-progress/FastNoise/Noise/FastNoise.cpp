@@ -32,28 +32,35 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <unordered_map>
 
-const FN_DECIMAL GRAD_X[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::GRAD_X[] =
 {
 	1, -1, 1, -1,
 	1, -1, 1, -1,
 	0, 0, 0, 0
 };
-const FN_DECIMAL GRAD_Y[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::GRAD_Y[] =
 {
 	1, 1, -1, -1,
 	0, 0, 0, 0,
 	1, -1, 1, -1
 };
-const FN_DECIMAL GRAD_Z[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::GRAD_Z[] =
 {
 	0, 0, 0, 0,
 	1, 1, -1, -1,
 	1, 1, -1, -1
 };
 
-const FN_DECIMAL GRAD_4D[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::GRAD_4D[] =
 {
 	0,1,1,1,0,1,1,-1,0,1,-1,1,0,1,-1,-1,
 	0,-1,1,1,0,-1,1,-1,0,-1,-1,1,0,-1,-1,-1,
@@ -65,7 +72,8 @@ const FN_DECIMAL GRAD_4D[] =
 	-1,1,1,0,-1,1,-1,0,-1,-1,1,0,-1,-1,-1,0
 };
 
-const FN_DECIMAL VAL_LUT[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::VAL_LUT[] =
 {
 	FN_DECIMAL(0.3490196078), FN_DECIMAL(0.4352941176), FN_DECIMAL(-0.4509803922), FN_DECIMAL(0.6392156863), FN_DECIMAL(0.5843137255), FN_DECIMAL(-0.1215686275), FN_DECIMAL(0.7176470588), FN_DECIMAL(-0.1058823529), FN_DECIMAL(0.3960784314), FN_DECIMAL(0.0431372549), FN_DECIMAL(-0.03529411765), FN_DECIMAL(0.3176470588), FN_DECIMAL(0.7254901961), FN_DECIMAL(0.137254902), FN_DECIMAL(0.8588235294), FN_DECIMAL(-0.8196078431),
 	FN_DECIMAL(-0.7960784314), FN_DECIMAL(-0.3333333333), FN_DECIMAL(-0.6705882353), FN_DECIMAL(-0.3882352941), FN_DECIMAL(0.262745098), FN_DECIMAL(0.3254901961), FN_DECIMAL(-0.6470588235), FN_DECIMAL(-0.9215686275), FN_DECIMAL(-0.5294117647), FN_DECIMAL(0.5294117647), FN_DECIMAL(-0.4666666667), FN_DECIMAL(0.8117647059), FN_DECIMAL(0.3803921569), FN_DECIMAL(0.662745098), FN_DECIMAL(0.03529411765), FN_DECIMAL(-0.6156862745),
@@ -85,7 +93,8 @@ const FN_DECIMAL VAL_LUT[] =
 	FN_DECIMAL(0.3333333333), FN_DECIMAL(-0.8431372549), FN_DECIMAL(0.2235294118), FN_DECIMAL(-0.3490196078), FN_DECIMAL(-0.6941176471), FN_DECIMAL(0.8823529412), FN_DECIMAL(0.4745098039), FN_DECIMAL(0.4666666667), FN_DECIMAL(-0.7411764706), FN_DECIMAL(-0.2705882353), FN_DECIMAL(0.968627451), FN_DECIMAL(0.8196078431), FN_DECIMAL(-0.662745098), FN_DECIMAL(-0.4352941176), FN_DECIMAL(-0.8666666667), FN_DECIMAL(-0.1529411765),
 };
 
-const FN_DECIMAL CELL_2D_X[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CELL_2D_X[] =
 {
 	FN_DECIMAL(-0.6440658039), FN_DECIMAL(-0.08028078721), FN_DECIMAL(0.9983546168), FN_DECIMAL(0.9869492062), FN_DECIMAL(0.9284746418), FN_DECIMAL(0.6051097552), FN_DECIMAL(-0.794167404), FN_DECIMAL(-0.3488667991), FN_DECIMAL(-0.943136526), FN_DECIMAL(-0.9968171318), FN_DECIMAL(0.8740961579), FN_DECIMAL(0.1421139764), FN_DECIMAL(0.4282553608), FN_DECIMAL(-0.9986665833), FN_DECIMAL(0.9996760121), FN_DECIMAL(-0.06248383632),
 	FN_DECIMAL(0.7120139305), FN_DECIMAL(0.8917660409), FN_DECIMAL(0.1094842955), FN_DECIMAL(-0.8730880804), FN_DECIMAL(0.2594811489), FN_DECIMAL(-0.6690063346), FN_DECIMAL(-0.9996834972), FN_DECIMAL(-0.8803608671), FN_DECIMAL(-0.8166554937), FN_DECIMAL(0.8955599676), FN_DECIMAL(-0.9398321388), FN_DECIMAL(0.07615451399), FN_DECIMAL(-0.7147270565), FN_DECIMAL(0.8707354457), FN_DECIMAL(-0.9580008579), FN_DECIMAL(0.4905965632),
@@ -104,7 +113,8 @@ const FN_DECIMAL CELL_2D_X[] =
 	FN_DECIMAL(-0.9581216256), FN_DECIMAL(0.552215082), FN_DECIMAL(-0.9296791922), FN_DECIMAL(0.643183699), FN_DECIMAL(0.9997325981), FN_DECIMAL(-0.4606920354), FN_DECIMAL(-0.2148721265), FN_DECIMAL(0.3482070809), FN_DECIMAL(0.3075517813), FN_DECIMAL(0.6274756393), FN_DECIMAL(0.8910881765), FN_DECIMAL(-0.6397771309), FN_DECIMAL(-0.4479080125), FN_DECIMAL(-0.5247665011), FN_DECIMAL(-0.8386507094), FN_DECIMAL(0.3901291416),
 	FN_DECIMAL(0.1458336921), FN_DECIMAL(0.01624613149), FN_DECIMAL(-0.8273199879), FN_DECIMAL(0.5611100679), FN_DECIMAL(-0.8380219841), FN_DECIMAL(-0.9856122234), FN_DECIMAL(-0.861398618), FN_DECIMAL(0.6398413916), FN_DECIMAL(0.2694510795), FN_DECIMAL(0.4327334514), FN_DECIMAL(-0.9960265354), FN_DECIMAL(-0.939570655), FN_DECIMAL(-0.8846996446), FN_DECIMAL(0.7642113189), FN_DECIMAL(-0.7002080528), FN_DECIMAL(0.664508256),
 };
-const FN_DECIMAL CELL_2D_Y[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CELL_2D_Y[] =
 {
 	FN_DECIMAL(0.7649700911), FN_DECIMAL(0.9967722885), FN_DECIMAL(0.05734160033), FN_DECIMAL(-0.1610318741), FN_DECIMAL(0.371395799), FN_DECIMAL(-0.7961420628), FN_DECIMAL(0.6076990492), FN_DECIMAL(-0.9371723195), FN_DECIMAL(0.3324056156), FN_DECIMAL(0.07972205329), FN_DECIMAL(-0.4857529277), FN_DECIMAL(-0.9898503007), FN_DECIMAL(0.9036577593), FN_DECIMAL(0.05162417479), FN_DECIMAL(-0.02545330525), FN_DECIMAL(-0.998045976),
 	FN_DECIMAL(-0.7021653386), FN_DECIMAL(-0.4524967717), FN_DECIMAL(-0.9939885256), FN_DECIMAL(-0.4875625128), FN_DECIMAL(-0.9657481729), FN_DECIMAL(-0.7432567015), FN_DECIMAL(0.02515761212), FN_DECIMAL(0.4743044842), FN_DECIMAL(0.5771254669), FN_DECIMAL(0.4449408324), FN_DECIMAL(0.3416365773), FN_DECIMAL(0.9970960285), FN_DECIMAL(0.6994034849), FN_DECIMAL(0.4917517499), FN_DECIMAL(0.286765333), FN_DECIMAL(0.8713868327),
@@ -123,7 +133,8 @@ const FN_DECIMAL CELL_2D_Y[] =
 	FN_DECIMAL(-0.2863615732), FN_DECIMAL(0.8337016872), FN_DECIMAL(0.3683701937), FN_DECIMAL(0.7657119102), FN_DECIMAL(-0.02312427772), FN_DECIMAL(0.8875600535), FN_DECIMAL(0.976642191), FN_DECIMAL(0.9374176384), FN_DECIMAL(0.9515313457), FN_DECIMAL(-0.7786361937), FN_DECIMAL(-0.4538302125), FN_DECIMAL(-0.7685604874), FN_DECIMAL(-0.8940796454), FN_DECIMAL(-0.8512462154), FN_DECIMAL(0.5446696133), FN_DECIMAL(0.9207601495),
 	FN_DECIMAL(-0.9893091197), FN_DECIMAL(-0.9998680229), FN_DECIMAL(0.5617309299), FN_DECIMAL(-0.8277411985), FN_DECIMAL(0.545636467), FN_DECIMAL(0.1690223212), FN_DECIMAL(-0.5079295433), FN_DECIMAL(0.7685069899), FN_DECIMAL(-0.9630140787), FN_DECIMAL(0.9015219132), FN_DECIMAL(0.08905695279), FN_DECIMAL(-0.3423550559), FN_DECIMAL(-0.4661614943), FN_DECIMAL(-0.6449659371), FN_DECIMAL(0.7139388509), FN_DECIMAL(0.7472809229),
 };
-const FN_DECIMAL CELL_3D_X[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CELL_3D_X[] =
 {
 	FN_DECIMAL(0.3752498686), FN_DECIMAL(0.687188096), FN_DECIMAL(0.2248135212), FN_DECIMAL(0.6692006647), FN_DECIMAL(-0.4376476931), FN_DECIMAL(0.6139972552), FN_DECIMAL(0.9494563929), FN_DECIMAL(0.8065108882), FN_DECIMAL(-0.2218812853), FN_DECIMAL(0.8484661167), FN_DECIMAL(0.5551817596), FN_DECIMAL(0.2133903499), FN_DECIMAL(0.5195126593), FN_DECIMAL(-0.6440141975), FN_DECIMAL(-0.5192897331), FN_DECIMAL(-0.3697654077),
 	FN_DECIMAL(-0.07927779647), FN_DECIMAL(0.4187757321), FN_DECIMAL(-0.750078731), FN_DECIMAL(0.6579554632), FN_DECIMAL(-0.6859803838), FN_DECIMAL(-0.6878407087), FN_DECIMAL(0.9490848347), FN_DECIMAL(0.5795829433), FN_DECIMAL(-0.5325976529), FN_DECIMAL(-0.1363699466), FN_DECIMAL(0.417665879), FN_DECIMAL(-0.9108236468), FN_DECIMAL(0.4438605427), FN_DECIMAL(0.819294887), FN_DECIMAL(-0.4033873915), FN_DECIMAL(-0.2817317705),
@@ -142,7 +153,8 @@ const FN_DECIMAL CELL_3D_X[] =
 	FN_DECIMAL(-0.6874880269), FN_DECIMAL(-0.5115661773), FN_DECIMAL(-0.5534962601), FN_DECIMAL(0.5632777056), FN_DECIMAL(0.686191532), FN_DECIMAL(-0.05095871588), FN_DECIMAL(-0.06865785057), FN_DECIMAL(-0.5975288531), FN_DECIMAL(-0.6429790056), FN_DECIMAL(-0.3729361548), FN_DECIMAL(0.2237917666), FN_DECIMAL(0.6046773225), FN_DECIMAL(-0.5041542295), FN_DECIMAL(-0.03972191174), FN_DECIMAL(0.7028828406), FN_DECIMAL(-0.5560856498),
 	FN_DECIMAL(0.5898328456), FN_DECIMAL(-0.9308076766), FN_DECIMAL(0.4617069864), FN_DECIMAL(0.3190983137), FN_DECIMAL(0.9116567753), FN_DECIMAL(-0.45029554), FN_DECIMAL(0.3346334459), FN_DECIMAL(0.8525005645), FN_DECIMAL(0.2528483381), FN_DECIMAL(-0.8306630147), FN_DECIMAL(-0.6880390622), FN_DECIMAL(0.7448684026), FN_DECIMAL(-0.1963355843), FN_DECIMAL(-0.5900257974), FN_DECIMAL(0.9097057294), FN_DECIMAL(-0.2509196808),
 };
-const FN_DECIMAL CELL_3D_Y[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CELL_3D_Y[] =
 {
 	FN_DECIMAL(-0.6760585049), FN_DECIMAL(-0.09136176499), FN_DECIMAL(0.1681325679), FN_DECIMAL(-0.6688468686), FN_DECIMAL(-0.4822753902), FN_DECIMAL(-0.7891068824), FN_DECIMAL(-0.1877509944), FN_DECIMAL(0.548470914), FN_DECIMAL(-0.463339443), FN_DECIMAL(-0.4050542082), FN_DECIMAL(0.3218158513), FN_DECIMAL(0.2546493823), FN_DECIMAL(-0.3753271935), FN_DECIMAL(0.4745384887), FN_DECIMAL(0.481254652), FN_DECIMAL(-0.8934416489),
 	FN_DECIMAL(-0.6737085076), FN_DECIMAL(0.7469917228), FN_DECIMAL(0.3826230411), FN_DECIMAL(0.6751013678), FN_DECIMAL(-0.7248119515), FN_DECIMAL(-0.3224276742), FN_DECIMAL(-0.02076190936), FN_DECIMAL(-0.6404268166), FN_DECIMAL(-0.5292028444), FN_DECIMAL(0.7151414636), FN_DECIMAL(-0.6144655059), FN_DECIMAL(-0.369912124), FN_DECIMAL(0.6942067212), FN_DECIMAL(-0.4481558248), FN_DECIMAL(-0.6366894559), FN_DECIMAL(0.5956568471),
@@ -161,7 +173,8 @@ const FN_DECIMAL CELL_3D_Y[] =
 	FN_DECIMAL(0.7238407199), FN_DECIMAL(-0.7766913695), FN_DECIMAL(0.6460037842), FN_DECIMAL(0.2544775664), FN_DECIMAL(0.6488840578), FN_DECIMAL(0.805016833), FN_DECIMAL(-0.9183807036), FN_DECIMAL(0.4144046357), FN_DECIMAL(0.270587208), FN_DECIMAL(-0.8813684494), FN_DECIMAL(0.6985971877), FN_DECIMAL(-0.7795603017), FN_DECIMAL(-0.8624480731), FN_DECIMAL(0.5532697017), FN_DECIMAL(0.711179521), FN_DECIMAL(-0.7798160574),
 	FN_DECIMAL(0.5225859041), FN_DECIMAL(0.1261859368), FN_DECIMAL(0.3398033582), FN_DECIMAL(-0.7472173667), FN_DECIMAL(-0.4032647119), FN_DECIMAL(-0.4246578154), FN_DECIMAL(0.8481212377), FN_DECIMAL(-0.2144838537), FN_DECIMAL(0.3431714491), FN_DECIMAL(0.5310188231), FN_DECIMAL(0.6682978632), FN_DECIMAL(0.3110433206), FN_DECIMAL(0.9263293599), FN_DECIMAL(-0.6155600569), FN_DECIMAL(0.07169784399), FN_DECIMAL(0.8985888773),
 };
-const FN_DECIMAL CELL_3D_Z[] =
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CELL_3D_Z[] =
 {
 	FN_DECIMAL(-0.6341391283), FN_DECIMAL(-0.7207118346), FN_DECIMAL(0.9597866014), FN_DECIMAL(0.3237504235), FN_DECIMAL(-0.7588642466), FN_DECIMAL(-0.01782410481), FN_DECIMAL(0.2515593809), FN_DECIMAL(0.2207257205), FN_DECIMAL(-0.8579541106), FN_DECIMAL(0.3406410681), FN_DECIMAL(0.7669470462), FN_DECIMAL(-0.9431957648), FN_DECIMAL(0.7676171537), FN_DECIMAL(-0.6000491115), FN_DECIMAL(-0.7062096948), FN_DECIMAL(0.2550207115),
 	FN_DECIMAL(0.7347325213), FN_DECIMAL(0.5163625202), FN_DECIMAL(-0.5394270162), FN_DECIMAL(0.3336656285), FN_DECIMAL(-0.0638635111), FN_DECIMAL(-0.6503195787), FN_DECIMAL(0.3143356798), FN_DECIMAL(-0.5039217245), FN_DECIMAL(0.6605180464), FN_DECIMAL(-0.6855479011), FN_DECIMAL(-0.6693185756), FN_DECIMAL(0.1832083647), FN_DECIMAL(-0.5666258437), FN_DECIMAL(0.3576482138), FN_DECIMAL(-0.6571949095), FN_DECIMAL(-0.7522101635),
@@ -181,40 +194,166 @@ const FN_DECIMAL CELL_3D_Z[] =
 	FN_DECIMAL(0.615630723), FN_DECIMAL(0.3430367014), FN_DECIMAL(0.8193658136), FN_DECIMAL(-0.5829600957), FN_DECIMAL(0.07911697781), FN_DECIMAL(0.7854296063), FN_DECIMAL(-0.4107442306), FN_DECIMAL(0.4766964066), FN_DECIMAL(-0.9045999527), FN_DECIMAL(-0.1673856787), FN_DECIMAL(0.2828077348), FN_DECIMAL(-0.5902737632), FN_DECIMAL(-0.321506229), FN_DECIMAL(-0.5224513133), FN_DECIMAL(-0.4090169985), FN_DECIMAL(-0.3599685311),
 };
 
-static int FastFloor(FN_DECIMAL f) { return (f >= 0 ? (int)f : (int)f - 1); }
-static int FastRound(FN_DECIMAL f) { return (f >= 0) ? (int)(f + FN_DECIMAL(0.5)) : (int)(f - FN_DECIMAL(0.5)); }
+template <typename FN_DECIMAL> static int FastFloor(FN_DECIMAL f) { return (f >= 0 ? (int)f : (int)f - 1); }
+template <typename FN_DECIMAL> static int FastRound(FN_DECIMAL f) { return (f >= 0) ? (int)(f + FN_DECIMAL(0.5)) : (int)(f - FN_DECIMAL(0.5)); }
 static int FastAbs(int i) { return abs(i); }
-static FN_DECIMAL FastAbs(FN_DECIMAL f) { return fabs(f); }
-static FN_DECIMAL Lerp(FN_DECIMAL a, FN_DECIMAL b, FN_DECIMAL t) { return a + t * (b - a); }
-static FN_DECIMAL InterpHermiteFunc(FN_DECIMAL t) { return t*t*(3 - 2 * t); }
-static FN_DECIMAL InterpQuinticFunc(FN_DECIMAL t) { return t*t*t*(t*(t * 6 - 15) + 10); }
+template <typename FN_DECIMAL> static FN_DECIMAL FastAbs(FN_DECIMAL f) { return fabs(f); }
+template <typename FN_DECIMAL> static FN_DECIMAL Lerp(FN_DECIMAL a, FN_DECIMAL b, FN_DECIMAL t) { return a + t * (b - a); }
+template <typename FN_DECIMAL> static FN_DECIMAL InterpHermiteFunc(FN_DECIMAL t) { return t*t*(3 - 2 * t); }
+template <typename FN_DECIMAL> static FN_DECIMAL InterpQuinticFunc(FN_DECIMAL t) { return t*t*t*(t*(t * 6 - 15) + 10); }
+
+template <FastNoiseBase::Interp interp, typename FN_DECIMAL>
+static FN_DECIMAL InterpFunc(FN_DECIMAL t)
+{
+	switch (interp)
+	{
+	case FastNoiseBase::Hermite:
+		return InterpHermiteFunc(t);
+	case FastNoiseBase::Quintic:
+		return InterpQuinticFunc(t);
+	default:
+		return t;
+	}
+}
+
+template <FastNoiseBase::CellularDistanceFunction distanceFunction, typename FN_DECIMAL>
+static FN_DECIMAL CellularDistance(FN_DECIMAL vecX, FN_DECIMAL vecY)
+{
+	switch (distanceFunction)
+	{
+	case FastNoiseBase::Manhattan:
+		return FastAbs(vecX) + FastAbs(vecY);
+	case FastNoiseBase::Natural:
+		return (FastAbs(vecX) + FastAbs(vecY)) + (vecX * vecX + vecY * vecY);
+	default:
+		return vecX * vecX + vecY * vecY;
+	}
+}
+
+template <FastNoiseBase::CellularDistanceFunction distanceFunction, typename FN_DECIMAL>
+static FN_DECIMAL CellularDistance(FN_DECIMAL vecX, FN_DECIMAL vecY, FN_DECIMAL vecZ)
+{
+	switch (distanceFunction)
+	{
+	case FastNoiseBase::Manhattan:
+		return FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ);
+	case FastNoiseBase::Natural:
+		return (FastAbs(vecX) + FastAbs(vecY) + FastAbs(vecZ)) + (vecX * vecX + vecY * vecY + vecZ * vecZ);
+	default:
+		return vecX * vecX + vecY * vecY + vecZ * vecZ;
+	}
+}
+
+template <typename FN_DECIMAL>
+static FN_DECIMAL CatmullRom(FN_DECIMAL a, FN_DECIMAL b, FN_DECIMAL c, FN_DECIMAL d, FN_DECIMAL t)
+{
+	return b + FN_DECIMAL(0.5) * t * ((c - a) + t * ((2 * a - 5 * b + 4 * c - d) + t * (3 * (b - c) + d - a)));
+}
+
+template <typename FN_DECIMAL>
 static FN_DECIMAL CubicLerp(FN_DECIMAL a, FN_DECIMAL b, FN_DECIMAL c, FN_DECIMAL d, FN_DECIMAL t)
 {
 	FN_DECIMAL p = (d - c) - (a - b);
 	return t * t * t * p + t * t * ((a - b) - p) + t * (c - a) + b;
 }
 
-void FastNoise::SetSeed(int seed)
+struct PermTable
 {
-	m_seed = seed;
+	unsigned char perm[512];
+	unsigned char perm12[512];
 
-	std::mt19937 gen(seed);
+	explicit PermTable(int seed)
+	{
+		std::mt19937 gen(seed);
+
+		for (int i = 0; i < 256; i++)
+			perm[i] = i;
+
+		for (int j = 0; j < 256; j++)
+		{
+			std::uniform_int_distribution<> dis(0, 256 - j);
+			int k = dis(gen) + j;
+			int l = perm[j];
+			perm[j] = perm[j + 256] = perm[k];
+			perm[k] = l;
+			perm12[j] = perm12[j + 256] = perm[j] % 12;
+		}
+	}
+};
+
+// Tables are built once per seed and shared by every instance using that seed
+// A table is freed when the last instance holding it is destroyed or reseeded,
+// and it is no longer one of the most recently used tables kept alive by the cache
+// Each thread remembers its last seed so repeated seeds skip the lock
+static std::shared_ptr<const PermTable> GetPermTable(int seed)
+{
+	static thread_local int lastSeed;
+	static thread_local std::weak_ptr<const PermTable> lastTable;
+
+	std::shared_ptr<const PermTable> table = lastTable.lock();
+
+	if (table && lastSeed == seed)
+		return table;
+
+	static std::mutex cacheMutex;
+	static std::unordered_map<int, std::weak_ptr<const PermTable>> cache;
+	static size_t sweepSize = 64;
 
-	for (int i = 0; i < 256; i++)
-		m_perm[i] = i;
+	// Short lived instances that reuse a few seeds would otherwise rebuild the table every time
+	static const int recentCount = 16;
+	static std::shared_ptr<const PermTable> recent[recentCount];
 
-	for (int j = 0; j < 256; j++)
 	{
-		std::uniform_int_distribution<> dis(0, 256 - j);
-		int k = dis(gen) + j;
-		int l = m_perm[j];
-		m_perm[j] = m_perm[j + 256] = m_perm[k];
-		m_perm[k] = l;
-		m_perm12[j] = m_perm12[j + 256] = m_perm[j] % 12;
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		std::weak_ptr<const PermTable>& entry = cache[seed];
+		table = entry.lock();
+
+		if (!table)
+		{
+			table = std::make_shared<PermTable>(seed);
+			entry = table;
+
+			// Drop the entries of freed tables once the cache has doubled since the last sweep
+			if (cache.size() >= sweepSize)
+			{
+				for (auto it = cache.begin(); it != cache.end();)
+				{
+					if (it->second.expired())
+						it = cache.erase(it);
+					else
+						++it;
+				}
+				sweepSize = std::max(size_t(64), cache.size() * 2);
+			}
+		}
+
+		// Move the table to the front of the recently used list, the last one drops out
+		int i = 0;
+		while (i < recentCount - 1 && recent[i] != table)
+			i++;
+		for (; i > 0; i--)
+			recent[i] = std::move(recent[i - 1]);
+		recent[0] = table;
 	}
+
+	lastSeed = seed;
+	lastTable = table;
+	return table;
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SetSeed(int seed)
+{
+	m_seed = seed;
+
+	std::shared_ptr<const PermTable> table = GetPermTable(seed);
+	m_perm = table->perm;
+	m_perm12 = table->perm12;
+	m_permOwner = std::move(table);
 }
 
-void FastNoise::CalculateFractalBounding()
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::CalculateFractalBounding()
 {
 	float amp = m_gain;
 	float ampFractal = 1.0f;
@@ -226,7 +365,8 @@ void FastNoise::CalculateFractalBounding()
 	m_fractalBounding = 1.0f / ampFractal;
 }
 
-void FastNoise::SetCellularDistance2Indices(int cellularDistanceIndex0, int cellularDistanceIndex1)
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SetCellularDistance2Indices(int cellularDistanceIndex0, int cellularDistanceIndex1)
 {
 	m_cellularDistanceIndex0 = std::min(cellularDistanceIndex0, cellularDistanceIndex1);
 	m_cellularDistanceIndex1 = std::max(cellularDistanceIndex0, cellularDistanceIndex1);
@@ -235,33 +375,40 @@ void FastNoise::SetCellularDistance2Indices(int cellularDistanceIndex0, int cell
 	m_cellularDistanceIndex1 = std::min(std::max(m_cellularDistanceIndex1, 0), FN_CELLULAR_INDEX_MAX);
 }
 
-void FastNoise::GetCellularDistance2Indices(int& cellularDistanceIndex0, int& cellularDistanceIndex1) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetCellularDistance2Indices(int& cellularDistanceIndex0, int& cellularDistanceIndex1) const
 {
 	cellularDistanceIndex0 = m_cellularDistanceIndex0;
 	cellularDistanceIndex1 = m_cellularDistanceIndex1;
 }
 
-unsigned char FastNoise::Index2D_12(unsigned char offset, int x, int y) const
+template <typename FN_DECIMAL>
+unsigned char FastNoiseT<FN_DECIMAL>::Index2D_12(unsigned char offset, int x, int y) const
 {
 	return m_perm12[(x & 0xff) + m_perm[(y & 0xff) + offset]];
 }
-unsigned char FastNoise::Index3D_12(unsigned char offset, int x, int y, int z) const
+template <typename FN_DECIMAL>
+unsigned char FastNoiseT<FN_DECIMAL>::Index3D_12(unsigned char offset, int x, int y, int z) const
 {
 	return m_perm12[(x & 0xff) + m_perm[(y & 0xff) + m_perm[(z & 0xff) + offset]]];
 }
-unsigned char FastNoise::Index4D_32(unsigned char offset, int x, int y, int z, int w) const
+template <typename FN_DECIMAL>
+unsigned char FastNoiseT<FN_DECIMAL>::Index4D_32(unsigned char offset, int x, int y, int z, int w) const
 {
 	return m_perm[(x & 0xff) + m_perm[(y & 0xff) + m_perm[(z & 0xff) + m_perm[(w & 0xff) + offset]]]] & 31;
 }
-unsigned char FastNoise::Index2D_256(unsigned char offset, int x, int y) const
+template <typename FN_DECIMAL>
+unsigned char FastNoiseT<FN_DECIMAL>::Index2D_256(unsigned char offset, int x, int y) const
 {
 	return m_perm[(x & 0xff) + m_perm[(y & 0xff) + offset]];
 }
-unsigned char FastNoise::Index3D_256(unsigned char offset, int x, int y, int z) const
+template <typename FN_DECIMAL>
+unsigned char FastNoiseT<FN_DECIMAL>::Index3D_256(unsigned char offset, int x, int y, int z) const
 {
 	return m_perm[(x & 0xff) + m_perm[(y & 0xff) + m_perm[(z & 0xff) + offset]]];
 }
-unsigned char FastNoise::Index4D_256(unsigned char offset, int x, int y, int z, int w) const
+template <typename FN_DECIMAL>
+unsigned char FastNoiseT<FN_DECIMAL>::Index4D_256(unsigned char offset, int x, int y, int z, int w) const
 {
 	return m_perm[(x & 0xff) + m_perm[(y & 0xff) + m_perm[(z & 0xff) + m_perm[(w & 0xff) + offset]]]];
 }
@@ -272,6 +419,7 @@ unsigned char FastNoise::Index4D_256(unsigned char offset, int x, int y, int z,
 #define Z_PRIME 6971
 #define W_PRIME 1013
 
+template <typename FN_DECIMAL>
 static FN_DECIMAL ValCoord2D(int seed, int x, int y)
 {
 	int n = seed;
@@ -280,6 +428,7 @@ static FN_DECIMAL ValCoord2D(int seed, int x, int y)
 
 	return (n * n * n * 60493) / FN_DECIMAL(2147483648);
 }
+template <typename FN_DECIMAL>
 static FN_DECIMAL ValCoord3D(int seed, int x, int y, int z)
 {
 	int n = seed;
@@ -289,6 +438,7 @@ static FN_DECIMAL ValCoord3D(int seed, int x, int y, int z)
 
 	return (n * n * n * 60493) / FN_DECIMAL(2147483648);
 }
+template <typename FN_DECIMAL>
 static FN_DECIMAL ValCoord4D(int seed, int x, int y, int z, int w)
 {
 	int n = seed;
@@ -300,83 +450,205 @@ static FN_DECIMAL ValCoord4D(int seed, int x, int y, int z, int w)
 	return (n * n * n * 60493) / FN_DECIMAL(2147483648);
 }
 
-FN_DECIMAL FastNoise::ValCoord2DFast(unsigned char offset, int x, int y) const
+// Bulk hashing, the ValCoord hash in unsigned arithmetic so the fill loops vectorise
+static uint32_t HashCoord2D(int seed, int x, int y)
+{
+	uint32_t n = (uint32_t)seed;
+	n ^= X_PRIME * (uint32_t)x;
+	n ^= Y_PRIME * (uint32_t)y;
+
+	return n * n * n * 60493u;
+}
+static uint32_t HashCoord3D(int seed, int x, int y, int z)
+{
+	uint32_t n = (uint32_t)seed;
+	n ^= X_PRIME * (uint32_t)x;
+	n ^= Y_PRIME * (uint32_t)y;
+	n ^= Z_PRIME * (uint32_t)z;
+
+	return n * n * n * 60493u;
+}
+
+// SplitMix64 finalizer
+static uint64_t Mix64(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+#define GOLDEN_GAMMA 0x9E3779B97F4A7C15ull
+
+static uint64_t Hash64Coord(int seed, int x, int y, int z)
+{
+	return Mix64(Mix64((uint32_t)seed) + (uint32_t)x * GOLDEN_GAMMA + (uint32_t)y * 0xC2B2AE3D27D4EB4Full + (uint32_t)z * 0x165667B19E3779F9ull);
+}
+
+// Element counter of the SplitMix64 stream keyed by seed
+static uint64_t HashCounter(int seed, uint64_t counter)
+{
+	return Mix64(Mix64((uint32_t)seed) + (counter + 1) * GOLDEN_GAMMA);
+}
+
+// Converts hashes to the requested output, floating point outputs are scaled like ValCoord
+template <typename T>
+struct WhiteNoiseHash
+{
+	static T Get(int seed, int x, int y) { return (T)(int32_t)HashCoord2D(seed, x, y) / T(2147483648); }
+	static T Get(int seed, int x, int y, int z) { return (T)(int32_t)HashCoord3D(seed, x, y, z) / T(2147483648); }
+	static T Counter(int seed, uint64_t counter) { return (T)(int32_t)(HashCounter(seed, counter) >> 32) / T(2147483648); }
+};
+template <>
+struct WhiteNoiseHash<uint32_t>
+{
+	static uint32_t Get(int seed, int x, int y) { return HashCoord2D(seed, x, y); }
+	static uint32_t Get(int seed, int x, int y, int z) { return HashCoord3D(seed, x, y, z); }
+	static uint32_t Counter(int seed, uint64_t counter) { return (uint32_t)(HashCounter(seed, counter) >> 32); }
+};
+template <>
+struct WhiteNoiseHash<uint64_t>
+{
+	static uint64_t Get(int seed, int x, int y) { return Hash64Coord(seed, x, y, 0); }
+	static uint64_t Get(int seed, int x, int y, int z) { return Hash64Coord(seed, x, y, z); }
+	static uint64_t Counter(int seed, uint64_t counter) { return HashCounter(seed, counter); }
+};
+
+template <typename T>
+static void FillWhiteNoiseBox(int seed, T* out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize)
+{
+	for (int x = 0; x < xSize; x++)
+	{
+		for (int y = 0; y < ySize; y++)
+		{
+			for (int z = 0; z < zSize; z++)
+				*out++ = WhiteNoiseHash<T>::Get(seed, xStart + x, yStart + y, zStart + z);
+		}
+	}
+}
+
+template <typename T>
+static void FillWhiteNoiseSlice(int seed, T* out, int xStart, int yStart, int xSize, int ySize)
+{
+	for (int x = 0; x < xSize; x++)
+	{
+		for (int y = 0; y < ySize; y++)
+			*out++ = WhiteNoiseHash<T>::Get(seed, xStart + x, yStart + y);
+	}
+}
+
+template <typename T>
+static void WhiteNoiseBatch(int seed, const int* xs, const int* ys, const int* zs, T* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = WhiteNoiseHash<T>::Get(seed, xs[i], ys[i], zs[i]);
+}
+
+template <typename T>
+static void WhiteNoiseBatch(int seed, const int* xs, const int* ys, T* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = WhiteNoiseHash<T>::Get(seed, xs[i], ys[i]);
+}
+
+template <typename T>
+static void FillRandomStream(int seed, T* out, uint64_t counter, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = WhiteNoiseHash<T>::Counter(seed, counter + i);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::ValCoord2DFast(unsigned char offset, int x, int y) const
 {
 	return VAL_LUT[Index2D_256(offset, x, y)];
 }
-FN_DECIMAL FastNoise::ValCoord3DFast(unsigned char offset, int x, int y, int z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::ValCoord3DFast(unsigned char offset, int x, int y, int z) const
 {
 	return VAL_LUT[Index3D_256(offset, x, y, z)];
 }
 
-FN_DECIMAL FastNoise::GradCoord2D(unsigned char offset, int x, int y, FN_DECIMAL xd, FN_DECIMAL yd) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GradCoord2D(unsigned char offset, int x, int y, FN_DECIMAL xd, FN_DECIMAL yd) const
 {
 	unsigned char lutPos = Index2D_12(offset, x, y);
 
 	return xd*GRAD_X[lutPos] + yd*GRAD_Y[lutPos];
 }
-FN_DECIMAL FastNoise::GradCoord3D(unsigned char offset, int x, int y, int z, FN_DECIMAL xd, FN_DECIMAL yd, FN_DECIMAL zd) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GradCoord3D(unsigned char offset, int x, int y, int z, FN_DECIMAL xd, FN_DECIMAL yd, FN_DECIMAL zd) const
 {
 	unsigned char lutPos = Index3D_12(offset, x, y, z);
 
 	return xd*GRAD_X[lutPos] + yd*GRAD_Y[lutPos] + zd*GRAD_Z[lutPos];
 }
-FN_DECIMAL FastNoise::GradCoord4D(unsigned char offset, int x, int y, int z, int w, FN_DECIMAL xd, FN_DECIMAL yd, FN_DECIMAL zd, FN_DECIMAL wd) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GradCoord4D(unsigned char offset, int x, int y, int z, int w, FN_DECIMAL xd, FN_DECIMAL yd, FN_DECIMAL zd, FN_DECIMAL wd) const
 {
 	unsigned char lutPos = Index4D_32(offset, x, y, z, w) << 2;
 
 	return xd*GRAD_4D[lutPos] + yd*GRAD_4D[lutPos + 1] + zd*GRAD_4D[lutPos + 2] + wd*GRAD_4D[lutPos + 3];
 }
 
-FN_DECIMAL FastNoise::GetNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	x *= m_frequency;
-	y *= m_frequency;
-	z *= m_frequency;
+	return (this->*m_noise3D)(x * m_frequency, y * m_frequency, z * m_frequency);
+}
 
-	switch (m_noiseType)
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetNoise(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	return (this->*m_noise2D)(x * m_frequency, y * m_frequency);
+}
+
+template <typename FN_DECIMAL>
+template <class Select, FastNoiseBase::Interp interp>
+typename Select::Func3D FastNoiseT<FN_DECIMAL>::ResolveInterpNoise3D(NoiseType noiseType) const
+{
+	switch (noiseType)
 	{
 	case Value:
-		return SingleValue(0, x, y, z);
+		return Select::template Get3D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SingleValue<interp>>>();
 	case ValueFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SingleValueFractalFBM(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleValueFractalFBM<interp>>();
 		case Billow:
-			return SingleValueFractalBillow(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleValueFractalBillow<interp>>();
 		case RigidMulti:
-			return SingleValueFractalRigidMulti(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleValueFractalRigidMulti<interp>>();
 		default:
-			return 0;
+			return Select::template Get3D<&FastNoiseT::SingleZero>();
 		}
 	case Perlin:
-		return SinglePerlin(0, x, y, z);
+		return Select::template Get3D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SinglePerlin<interp>>>();
 	case PerlinFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SinglePerlinFractalFBM(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SinglePerlinFractalFBM<interp>>();
 		case Billow:
-			return SinglePerlinFractalBillow(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SinglePerlinFractalBillow<interp>>();
 		case RigidMulti:
-			return SinglePerlinFractalRigidMulti(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SinglePerlinFractalRigidMulti<interp>>();
 		default:
-			return 0;
+			return Select::template Get3D<&FastNoiseT::SingleZero>();
 		}
 	case Simplex:
-		return SingleSimplex(0, x, y, z);
+		return Select::template Get3D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SingleSimplex>>();
 	case SimplexFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SingleSimplexFractalFBM(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleSimplexFractalFBM>();
 		case Billow:
-			return SingleSimplexFractalBillow(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleSimplexFractalBillow>();
 		case RigidMulti:
-			return SingleSimplexFractalRigidMulti(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleSimplexFractalRigidMulti>();
 		default:
-			return 0;
+			return Select::template Get3D<&FastNoiseT::SingleZero>();
 		}
 	case Cellular:
 		switch (m_cellularReturnType)
@@ -384,73 +656,78 @@ FN_DECIMAL FastNoise::GetNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 		case CellValue:
 		case NoiseLookup:
 		case Distance:
-			return SingleCellular(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleCellular>();
 		default:
-			return SingleCellular2Edge(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleCellular2Edge>();
 		}
 	case WhiteNoise:
-		return GetWhiteNoise(x, y, z);
-		
+		return Select::template Get3D<&FastNoiseT::GetWhiteNoise>();
 	case Cubic:
-		return SingleCubic(0, x, y, z);
-		
+		return Select::template Get3D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SingleCubic>>();
 	case CubicFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SingleCubicFractalFBM(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleCubicFractalFBM>();
 		case Billow:
-			return SingleCubicFractalBillow(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleCubicFractalBillow>();
 		case RigidMulti:
-			return SingleCubicFractalRigidMulti(x, y, z);
+			return Select::template Get3D<&FastNoiseT::SingleCubicFractalRigidMulti>();
+		default:
+			return Select::template Get3D<&FastNoiseT::SingleZero>();
 		}
 	default:
-		return 0;
+		return Select::template Get3D<&FastNoiseT::SingleZero>();
 	}
 }
 
-FN_DECIMAL FastNoise::GetNoise(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <class Select, FastNoiseBase::Interp interp>
+typename Select::Func2D FastNoiseT<FN_DECIMAL>::ResolveInterpNoise2D(NoiseType noiseType) const
 {
-	x *= m_frequency;
-	y *= m_frequency;
-
-	switch (m_noiseType)
+	switch (noiseType)
 	{
 	case Value:
-		return SingleValue(0, x, y);
+		return Select::template Get2D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SingleValue<interp>>>();
 	case ValueFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SingleValueFractalFBM(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleValueFractalFBM<interp>>();
 		case Billow:
-			return SingleValueFractalBillow(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleValueFractalBillow<interp>>();
 		case RigidMulti:
-			return SingleValueFractalRigidMulti(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleValueFractalRigidMulti<interp>>();
+		default:
+			return Select::template Get2D<&FastNoiseT::SingleZero>();
 		}
 	case Perlin:
-		return SinglePerlin(0, x, y);
+		return Select::template Get2D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SinglePerlin<interp>>>();
 	case PerlinFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SinglePerlinFractalFBM(x, y);
+			return Select::template Get2D<&FastNoiseT::SinglePerlinFractalFBM<interp>>();
 		case Billow:
-			return SinglePerlinFractalBillow(x, y);
+			return Select::template Get2D<&FastNoiseT::SinglePerlinFractalBillow<interp>>();
 		case RigidMulti:
-			return SinglePerlinFractalRigidMulti(x, y);
+			return Select::template Get2D<&FastNoiseT::SinglePerlinFractalRigidMulti<interp>>();
+		default:
+			return Select::template Get2D<&FastNoiseT::SingleZero>();
 		}
 	case Simplex:
-		return SingleSimplex(0, x, y);
+		return Select::template Get2D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SingleSimplex>>();
 	case SimplexFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SingleSimplexFractalFBM(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleSimplexFractalFBM>();
 		case Billow:
-			return SingleSimplexFractalBillow(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleSimplexFractalBillow>();
 		case RigidMulti:
-			return SingleSimplexFractalRigidMulti(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleSimplexFractalRigidMulti>();
+		default:
+			return Select::template Get2D<&FastNoiseT::SingleZero>();
 		}
 	case Cellular:
 		switch (m_cellularReturnType)
@@ -458,211 +735,541 @@ FN_DECIMAL FastNoise::GetNoise(FN_DECIMAL x, FN_DECIMAL y) const
 		case CellValue:
 		case NoiseLookup:
 		case Distance:
-			return SingleCellular(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleCellular>();
 		default:
-			return SingleCellular2Edge(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleCellular2Edge>();
 		}
 	case WhiteNoise:
-		return GetWhiteNoise(x, y);
+		return Select::template Get2D<&FastNoiseT::GetWhiteNoise>();
 	case Cubic:
-		return SingleCubic(0, x, y);
+		return Select::template Get2D<&FastNoiseT::SingleNoOffset<&FastNoiseT::SingleCubic>>();
 	case CubicFractal:
 		switch (m_fractalType)
 		{
 		case FBM:
-			return SingleCubicFractalFBM(x, y);
-		case Billow:	 
-			return SingleCubicFractalBillow(x, y);
-		case RigidMulti: 
-			return SingleCubicFractalRigidMulti(x, y);
+			return Select::template Get2D<&FastNoiseT::SingleCubicFractalFBM>();
+		case Billow:
+			return Select::template Get2D<&FastNoiseT::SingleCubicFractalBillow>();
+		case RigidMulti:
+			return Select::template Get2D<&FastNoiseT::SingleCubicFractalRigidMulti>();
+		default:
+			return Select::template Get2D<&FastNoiseT::SingleZero>();
 		}
+	default:
+		return Select::template Get2D<&FastNoiseT::SingleZero>();
 	}
-	return 0;
 }
 
-// White Noise
-FN_DECIMAL FastNoise::GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
+template <typename FN_DECIMAL>
+typename FastNoiseT<FN_DECIMAL>::Noise3DFunc FastNoiseT<FN_DECIMAL>::ResolveNoise3D(NoiseType noiseType) const
 {
-	return ValCoord4D(m_seed,
-		*reinterpret_cast<int*>(&x) ^ (*reinterpret_cast<int*>(&x) >> 16),
-		*reinterpret_cast<int*>(&y) ^ (*reinterpret_cast<int*>(&y) >> 16),
-		*reinterpret_cast<int*>(&z) ^ (*reinterpret_cast<int*>(&z) >> 16),
-		*reinterpret_cast<int*>(&w) ^ (*reinterpret_cast<int*>(&w) >> 16));
+	return ResolveSelectNoise3D<KernelSelect>(noiseType);
 }
 
-FN_DECIMAL FastNoise::GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+template <class Select>
+typename Select::Func3D FastNoiseT<FN_DECIMAL>::ResolveSelectNoise3D(NoiseType noiseType) const
 {
-	return ValCoord3D(m_seed,
-		*reinterpret_cast<int*>(&x) ^ (*reinterpret_cast<int*>(&x) >> 16),
-		*reinterpret_cast<int*>(&y) ^ (*reinterpret_cast<int*>(&y) >> 16),
-		*reinterpret_cast<int*>(&z) ^ (*reinterpret_cast<int*>(&z) >> 16));
+	switch (m_interp)
+	{
+	case Linear:
+		return ResolveInterpNoise3D<Select, Linear>(noiseType);
+	case Hermite:
+		return ResolveInterpNoise3D<Select, Hermite>(noiseType);
+	default:
+		return ResolveInterpNoise3D<Select, Quintic>(noiseType);
+	}
 }
 
-FN_DECIMAL FastNoise::GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+typename FastNoiseT<FN_DECIMAL>::NoiseBatch3DFunc FastNoiseT<FN_DECIMAL>::ResolveNoiseBatch3D() const
 {
-	return ValCoord2D(m_seed,
-		*reinterpret_cast<int*>(&x) ^ (*reinterpret_cast<int*>(&x) >> 16),
-		*reinterpret_cast<int*>(&y) ^ (*reinterpret_cast<int*>(&y) >> 16));
+	// Simplex has block versions without branches, everything else runs its kernel inlined in a loop
+	switch (m_noiseType)
+	{
+	case Simplex:
+		return &FastNoiseT::SimplexBatch3D;
+	case SimplexFractal:
+		switch (m_fractalType)
+		{
+		case FBM:
+			return &FastNoiseT::SimplexFractalBatch3D<FBM>;
+		case Billow:
+			return &FastNoiseT::SimplexFractalBatch3D<Billow>;
+		case RigidMulti:
+			return &FastNoiseT::SimplexFractalBatch3D<RigidMulti>;
+		default:
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+	return ResolveSelectNoise3D<BatchSelect>(m_noiseType);
+}
+
+template <typename FN_DECIMAL>
+typename FastNoiseT<FN_DECIMAL>::Noise2DFunc FastNoiseT<FN_DECIMAL>::ResolveNoise2D(NoiseType noiseType) const
+{
+	return ResolveSelectNoise2D<KernelSelect>(noiseType);
 }
 
-FN_DECIMAL FastNoise::GetWhiteNoiseInt(int x, int y, int z, int w) const
+template <typename FN_DECIMAL>
+template <class Select>
+typename Select::Func2D FastNoiseT<FN_DECIMAL>::ResolveSelectNoise2D(NoiseType noiseType) const
 {
-	return ValCoord4D(m_seed, x, y, z, w);
+	switch (m_interp)
+	{
+	case Linear:
+		return ResolveInterpNoise2D<Select, Linear>(noiseType);
+	case Hermite:
+		return ResolveInterpNoise2D<Select, Hermite>(noiseType);
+	default:
+		return ResolveInterpNoise2D<Select, Quintic>(noiseType);
+	}
 }
 
-FN_DECIMAL FastNoise::GetWhiteNoiseInt(int x, int y, int z) const
+template <typename FN_DECIMAL>
+typename FastNoiseT<FN_DECIMAL>::NoiseBatch2DFunc FastNoiseT<FN_DECIMAL>::ResolveNoiseBatch2D() const
 {
-	return ValCoord3D(m_seed, x, y, z);
+	// Simplex has block versions without branches, everything else runs its kernel inlined in a loop
+	switch (m_noiseType)
+	{
+	case Simplex:
+		return &FastNoiseT::SimplexBatch2D;
+	case SimplexFractal:
+		switch (m_fractalType)
+		{
+		case FBM:
+			return &FastNoiseT::SimplexFractalBatch2D<FBM>;
+		case Billow:
+			return &FastNoiseT::SimplexFractalBatch2D<Billow>;
+		case RigidMulti:
+			return &FastNoiseT::SimplexFractalBatch2D<RigidMulti>;
+		default:
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+	return ResolveSelectNoise2D<BatchSelect>(m_noiseType);
 }
 
-FN_DECIMAL FastNoise::GetWhiteNoiseInt(int x, int y) const
+template <typename FN_DECIMAL>
+typename FastNoiseT<FN_DECIMAL>::Octave3DFunc FastNoiseT<FN_DECIMAL>::ResolveOctave3D(NoiseType noiseType) const
 {
-	return ValCoord2D(m_seed, x, y);
+	switch (noiseType)
+	{
+	case ValueFractal:
+		switch (m_interp)
+		{
+		case Linear:
+			return &FastNoiseT::SingleValue<Linear>;
+		case Hermite:
+			return &FastNoiseT::SingleValue<Hermite>;
+		default:
+			return &FastNoiseT::SingleValue<Quintic>;
+		}
+	case PerlinFractal:
+		switch (m_interp)
+		{
+		case Linear:
+			return &FastNoiseT::SinglePerlin<Linear>;
+		case Hermite:
+			return &FastNoiseT::SinglePerlin<Hermite>;
+		default:
+			return &FastNoiseT::SinglePerlin<Quintic>;
+		}
+	case SimplexFractal:
+		return &FastNoiseT::SingleSimplex;
+	case CubicFractal:
+		return &FastNoiseT::SingleCubic;
+	default:
+		return nullptr;
+	}
 }
 
-// Value Noise
-FN_DECIMAL FastNoise::GetValueFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+typename FastNoiseT<FN_DECIMAL>::Octave2DFunc FastNoiseT<FN_DECIMAL>::ResolveOctave2D(NoiseType noiseType) const
 {
-	x *= m_frequency;
-	y *= m_frequency;
-	z *= m_frequency;
+	switch (noiseType)
+	{
+	case ValueFractal:
+		switch (m_interp)
+		{
+		case Linear:
+			return &FastNoiseT::SingleValue<Linear>;
+		case Hermite:
+			return &FastNoiseT::SingleValue<Hermite>;
+		default:
+			return &FastNoiseT::SingleValue<Quintic>;
+		}
+	case PerlinFractal:
+		switch (m_interp)
+		{
+		case Linear:
+			return &FastNoiseT::SinglePerlin<Linear>;
+		case Hermite:
+			return &FastNoiseT::SinglePerlin<Hermite>;
+		default:
+			return &FastNoiseT::SinglePerlin<Quintic>;
+		}
+	case SimplexFractal:
+		return &FastNoiseT::SingleSimplex;
+	case CubicFractal:
+		return &FastNoiseT::SingleCubic;
+	default:
+		return nullptr;
+	}
+}
 
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::AccumulateOctave(FN_DECIMAL& sum, FN_DECIMAL noise, FN_DECIMAL amp, bool first) const
+{
 	switch (m_fractalType)
 	{
 	case FBM:
-		return SingleValueFractalFBM(x, y, z);
+		sum = first ? noise : sum + noise * amp;
+		return sum * m_fractalBounding;
 	case Billow:
-		return SingleValueFractalBillow(x, y, z);
+		noise = FastAbs(noise) * 2 - 1;
+		sum = first ? noise : sum + noise * amp;
+		return sum * m_fractalBounding;
 	case RigidMulti:
-		return SingleValueFractalRigidMulti(x, y, z);
+		noise = 1 - FastAbs(noise);
+		sum = first ? noise : sum - noise * amp;
+		return sum;
 	default:
 		return 0;
 	}
 }
 
-FN_DECIMAL FastNoise::SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+// True when the octaves still to come, with total amplitude ampLeft, cannot move sum across the threshold
+template <typename FN_DECIMAL>
+bool FastNoiseT<FN_DECIMAL>::OctavesDecide(FN_DECIMAL sum, FN_DECIMAL ampLeft, FN_DECIMAL threshold, bool& above) const
 {
-	FN_DECIMAL sum = SingleValue(m_perm[0], x, y, z);
-	FN_DECIMAL amp = 1;
-	int i = 0;
+	// Every octave adds within [-amp, amp], RigidMulti only subtracts
+	// Slack covers rounding differences to the full evaluation
+	FN_DECIMAL slack = ampLeft * FN_DECIMAL(0.001) + FN_DECIMAL(0.0001);
+	FN_DECIMAL low = sum - ampLeft - slack;
+	FN_DECIMAL high = sum + (m_fractalType == RigidMulti ? 0 : ampLeft) + slack;
+	FN_DECIMAL scale = m_fractalType == RigidMulti ? 1 : m_fractalBounding;
 
-	while (++i < m_octaves)
+	if (low * scale > threshold)
 	{
-		x *= m_lacunarity;
-		y *= m_lacunarity;
-		z *= m_lacunarity;
-
-		amp *= m_gain;
-		sum += SingleValue(m_perm[i], x, y, z) * amp;
+		above = true;
+		return true;
 	}
-
-	return sum * m_fractalBounding;
+	if (high * scale <= threshold)
+	{
+		above = false;
+		return true;
+	}
+	return false;
 }
 
-FN_DECIMAL FastNoise::SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+bool FastNoiseT<FN_DECIMAL>::IsAbove(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL threshold) const
 {
-	FN_DECIMAL sum = FastAbs(SingleValue(m_perm[0], x, y, z)) * 2 - 1;
+	Octave3DFunc octave = ResolveOctave3D(m_noiseType);
+
+	if (!octave)
+		return GetNoise(x, y, z) > threshold;
+
+	x *= m_frequency;
+	y *= m_frequency;
+	z *= m_frequency;
+
+	FN_DECIMAL sum = 0;
 	FN_DECIMAL amp = 1;
-	int i = 0;
+	FN_DECIMAL ampLeft = 0;
+	bool above;
 
-	while (++i < m_octaves)
+	for (int i = 1; i < m_octaves; i++)
+		ampLeft = (ampLeft + 1) * m_gain;
+
+	FN_DECIMAL value = AccumulateOctave(sum, (this->*octave)(m_perm[0], x, y, z), amp, true);
+
+	for (int i = 1; i < m_octaves; i++)
 	{
+		if (OctavesDecide(sum, ampLeft, threshold, above))
+			return above;
+
 		x *= m_lacunarity;
 		y *= m_lacunarity;
 		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum += (FastAbs(SingleValue(m_perm[i], x, y, z)) * 2 - 1) * amp;
+		ampLeft -= amp;
+		value = AccumulateOctave(sum, (this->*octave)(m_perm[i], x, y, z), amp, false);
 	}
 
-	return sum * m_fractalBounding;
+	return value > threshold;
 }
 
-FN_DECIMAL FastNoise::SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+bool FastNoiseT<FN_DECIMAL>::IsAbove(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL threshold) const
 {
-	FN_DECIMAL sum = 1 - FastAbs(SingleValue(m_perm[0], x, y, z));
+	Octave2DFunc octave = ResolveOctave2D(m_noiseType);
+
+	if (!octave)
+		return GetNoise(x, y) > threshold;
+
+	x *= m_frequency;
+	y *= m_frequency;
+
+	FN_DECIMAL sum = 0;
 	FN_DECIMAL amp = 1;
-	int i = 0;
+	FN_DECIMAL ampLeft = 0;
+	bool above;
 
-	while (++i < m_octaves)
+	for (int i = 1; i < m_octaves; i++)
+		ampLeft = (ampLeft + 1) * m_gain;
+
+	FN_DECIMAL value = AccumulateOctave(sum, (this->*octave)(m_perm[0], x, y), amp, true);
+
+	for (int i = 1; i < m_octaves; i++)
 	{
+		if (OctavesDecide(sum, ampLeft, threshold, above))
+			return above;
+
 		x *= m_lacunarity;
 		y *= m_lacunarity;
-		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum -= (1 - FastAbs(SingleValue(m_perm[i], x, y, z))) * amp;
+		ampLeft -= amp;
+		value = AccumulateOctave(sum, (this->*octave)(m_perm[i], x, y), amp, false);
 	}
 
-	return sum;
+	return value > threshold;
 }
 
-FN_DECIMAL FastNoise::GetValue(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::UpdateNoiseFuncs()
 {
-	return SingleValue(0, x * m_frequency, y * m_frequency, z * m_frequency);
+	m_noise2D = ResolveNoise2D(m_noiseType);
+	m_noise3D = ResolveNoise3D(m_noiseType);
+	m_noiseBatch2D = ResolveNoiseBatch2D();
+	m_noiseBatch3D = ResolveNoiseBatch3D();
 }
 
-FN_DECIMAL FastNoise::SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetNoiseBatch(const FN_DECIMAL* xs, const FN_DECIMAL* ys, const FN_DECIMAL* zs, FN_DECIMAL* out, size_t count) const
 {
-	int x0 = FastFloor(x);
-	int y0 = FastFloor(y);
-	int z0 = FastFloor(z);
-	int x1 = x0 + 1;
-	int y1 = y0 + 1;
-	int z1 = z0 + 1;
+	(this->*m_noiseBatch3D)(xs, ys, zs, out, count);
+}
 
-	FN_DECIMAL xs, ys, zs;
-	switch (m_interp)
-	{
-	case Linear:
-		xs = x - (FN_DECIMAL)x0;
-		ys = y - (FN_DECIMAL)y0;
-		zs = z - (FN_DECIMAL)z0;
-		break;
-	case Hermite:
-		xs = InterpHermiteFunc(x - (FN_DECIMAL)x0);
-		ys = InterpHermiteFunc(y - (FN_DECIMAL)y0);
-		zs = InterpHermiteFunc(z - (FN_DECIMAL)z0);
-		break;
-	case Quintic:
-		xs = InterpQuinticFunc(x - (FN_DECIMAL)x0);
-		ys = InterpQuinticFunc(y - (FN_DECIMAL)y0);
-		zs = InterpQuinticFunc(z - (FN_DECIMAL)z0);
-		break;
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetNoiseBatch(const FN_DECIMAL* xs, const FN_DECIMAL* ys, FN_DECIMAL* out, size_t count) const
+{
+	(this->*m_noiseBatch2D)(xs, ys, out, count);
+}
+
+template <typename FN_DECIMAL>
+bool FastNoiseT<FN_DECIMAL>::IsCellPeriodic() const
+{
+	switch (m_noiseType)
+	{
+	case Value:
+	case Perlin:
+	case Cubic:
+		return true;
+	case ValueFractal:
+	case PerlinFractal:
+	case CubicFractal:
+		// Octave i samples at position * lacunarity^i, a whole number of periods only for integer lacunarity
+		return m_lacunarity == floor(m_lacunarity);
+	default:
+		return false;
 	}
+}
 
-	FN_DECIMAL xf00 = Lerp(ValCoord3DFast(offset, x0, y0, z0), ValCoord3DFast(offset, x1, y0, z0), xs);
-	FN_DECIMAL xf10 = Lerp(ValCoord3DFast(offset, x0, y1, z0), ValCoord3DFast(offset, x1, y1, z0), xs);
-	FN_DECIMAL xf01 = Lerp(ValCoord3DFast(offset, x0, y0, z1), ValCoord3DFast(offset, x1, y0, z1), xs);
-	FN_DECIMAL xf11 = Lerp(ValCoord3DFast(offset, x0, y1, z1), ValCoord3DFast(offset, x1, y1, z1), xs);
+static double WrapCell(double f)
+{
+	double cell = floor(f);
+	return (cell - 256 * floor(cell / 256)) + (f - cell);
+}
 
-	FN_DECIMAL yf0 = Lerp(xf00, xf10, ys);
-	FN_DECIMAL yf1 = Lerp(xf01, xf11, ys);
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetNoiseLarge(double x, double y, double z) const
+{
+	x *= m_frequency;
+	y *= m_frequency;
+	z *= m_frequency;
 
-	return Lerp(yf0, yf1, zs);
+	if (IsCellPeriodic())
+	{
+		x = WrapCell(x);
+		y = WrapCell(y);
+		z = WrapCell(z);
+	}
+	return (this->*m_noise3D)(FN_DECIMAL(x), FN_DECIMAL(y), FN_DECIMAL(z));
 }
 
-FN_DECIMAL FastNoise::GetValueFractal(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetNoiseLarge(double x, double y) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
 
-	switch (m_fractalType)
+	if (IsCellPeriodic())
 	{
-	case FBM:
-		return SingleValueFractalFBM(x, y);
-	case Billow:
-		return SingleValueFractalBillow(x, y);
-	case RigidMulti:
-		return SingleValueFractalRigidMulti(x, y);
-	default:
-		return 0;
+		x = WrapCell(x);
+		y = WrapCell(y);
 	}
+	return (this->*m_noise2D)(FN_DECIMAL(x), FN_DECIMAL(y));
+}
+
+// White Noise
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
+{
+	return ValCoord4D<FN_DECIMAL>(m_seed,
+		*reinterpret_cast<int*>(&x) ^ (*reinterpret_cast<int*>(&x) >> 16),
+		*reinterpret_cast<int*>(&y) ^ (*reinterpret_cast<int*>(&y) >> 16),
+		*reinterpret_cast<int*>(&z) ^ (*reinterpret_cast<int*>(&z) >> 16),
+		*reinterpret_cast<int*>(&w) ^ (*reinterpret_cast<int*>(&w) >> 16));
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+{
+	return ValCoord3D<FN_DECIMAL>(m_seed,
+		*reinterpret_cast<int*>(&x) ^ (*reinterpret_cast<int*>(&x) >> 16),
+		*reinterpret_cast<int*>(&y) ^ (*reinterpret_cast<int*>(&y) >> 16),
+		*reinterpret_cast<int*>(&z) ^ (*reinterpret_cast<int*>(&z) >> 16));
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	return ValCoord2D<FN_DECIMAL>(m_seed,
+		*reinterpret_cast<int*>(&x) ^ (*reinterpret_cast<int*>(&x) >> 16),
+		*reinterpret_cast<int*>(&y) ^ (*reinterpret_cast<int*>(&y) >> 16));
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetWhiteNoiseInt(int x, int y, int z, int w) const
+{
+	return ValCoord4D<FN_DECIMAL>(m_seed, x, y, z, w);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetWhiteNoiseInt(int x, int y, int z) const
+{
+	return ValCoord3D<FN_DECIMAL>(m_seed, x, y, z);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetWhiteNoiseInt(int x, int y) const
+{
+	return ValCoord2D<FN_DECIMAL>(m_seed, x, y);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillWhiteNoiseIntSet(FN_DECIMAL* out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize) const
+{
+	FillWhiteNoiseBox(m_seed, out, xStart, yStart, zStart, xSize, ySize, zSize);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillWhiteNoiseIntSet(uint32_t* out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize) const
+{
+	FillWhiteNoiseBox(m_seed, out, xStart, yStart, zStart, xSize, ySize, zSize);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillWhiteNoiseIntSet(uint64_t* out, int xStart, int yStart, int zStart, int xSize, int ySize, int zSize) const
+{
+	FillWhiteNoiseBox(m_seed, out, xStart, yStart, zStart, xSize, ySize, zSize);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillWhiteNoiseIntSet(FN_DECIMAL* out, int xStart, int yStart, int xSize, int ySize) const
+{
+	FillWhiteNoiseSlice(m_seed, out, xStart, yStart, xSize, ySize);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillWhiteNoiseIntSet(uint32_t* out, int xStart, int yStart, int xSize, int ySize) const
+{
+	FillWhiteNoiseSlice(m_seed, out, xStart, yStart, xSize, ySize);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillWhiteNoiseIntSet(uint64_t* out, int xStart, int yStart, int xSize, int ySize) const
+{
+	FillWhiteNoiseSlice(m_seed, out, xStart, yStart, xSize, ySize);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetWhiteNoiseIntBatch(const int* xs, const int* ys, const int* zs, FN_DECIMAL* out, size_t count) const
+{
+	WhiteNoiseBatch(m_seed, xs, ys, zs, out, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetWhiteNoiseIntBatch(const int* xs, const int* ys, const int* zs, uint32_t* out, size_t count) const
+{
+	WhiteNoiseBatch(m_seed, xs, ys, zs, out, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetWhiteNoiseIntBatch(const int* xs, const int* ys, const int* zs, uint64_t* out, size_t count) const
+{
+	WhiteNoiseBatch(m_seed, xs, ys, zs, out, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetWhiteNoiseIntBatch(const int* xs, const int* ys, FN_DECIMAL* out, size_t count) const
+{
+	WhiteNoiseBatch(m_seed, xs, ys, out, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetWhiteNoiseIntBatch(const int* xs, const int* ys, uint32_t* out, size_t count) const
+{
+	WhiteNoiseBatch(m_seed, xs, ys, out, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetWhiteNoiseIntBatch(const int* xs, const int* ys, uint64_t* out, size_t count) const
+{
+	WhiteNoiseBatch(m_seed, xs, ys, out, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillRandom(FN_DECIMAL* out, uint64_t counter, size_t count) const
+{
+	FillRandomStream(m_seed, out, counter, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillRandom(uint32_t* out, uint64_t counter, size_t count) const
+{
+	FillRandomStream(m_seed, out, counter, count);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::FillRandom(uint64_t* out, uint64_t counter, size_t count) const
+{
+	FillRandomStream(m_seed, out, counter, count);
+}
+
+// Value Noise
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetValueFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+
+{
+	return (this->*ResolveNoise3D(ValueFractal))(x * m_frequency, y * m_frequency, z * m_frequency);
 }
 
-FN_DECIMAL FastNoise::SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	FN_DECIMAL sum = SingleValue(m_perm[0], x, y);
+	FN_DECIMAL sum = SingleValue<interp>(m_perm[0], x, y, z);
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -670,17 +1277,20 @@ FN_DECIMAL FastNoise::SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 	{
 		x *= m_lacunarity;
 		y *= m_lacunarity;
+		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum += SingleValue(m_perm[i], x, y) * amp;
+		sum += SingleValue<interp>(m_perm[i], x, y, z) * amp;
 	}
 
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	FN_DECIMAL sum = FastAbs(SingleValue(m_perm[0], x, y)) * 2 - 1;
+	FN_DECIMAL sum = FastAbs(SingleValue<interp>(m_perm[0], x, y, z)) * 2 - 1;
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -688,16 +1298,20 @@ FN_DECIMAL FastNoise::SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
 	{
 		x *= m_lacunarity;
 		y *= m_lacunarity;
+		z *= m_lacunarity;
+
 		amp *= m_gain;
-		sum += (FastAbs(SingleValue(m_perm[i], x, y)) * 2 - 1) * amp;
+		sum += (FastAbs(SingleValue<interp>(m_perm[i], x, y, z)) * 2 - 1) * amp;
 	}
 
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	FN_DECIMAL sum = 1 - FastAbs(SingleValue(m_perm[0], x, y));
+	FN_DECIMAL sum = 1 - FastAbs(SingleValue<interp>(m_perm[0], x, y, z));
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -705,43 +1319,133 @@ FN_DECIMAL FastNoise::SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) c
 	{
 		x *= m_lacunarity;
 		y *= m_lacunarity;
+		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum -= (1 - FastAbs(SingleValue(m_perm[i], x, y))) * amp;
+		sum -= (1 - FastAbs(SingleValue<interp>(m_perm[i], x, y, z))) * amp;
 	}
 
 	return sum;
 }
 
-FN_DECIMAL FastNoise::GetValue(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetValue(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+
 {
-	return SingleValue(0, x * m_frequency, y * m_frequency);
+	return (this->*ResolveNoise3D(Value))(x * m_frequency, y * m_frequency, z * m_frequency);
 }
 
-FN_DECIMAL FastNoise::SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	int x0 = FastFloor(x);
 	int y0 = FastFloor(y);
+	int z0 = FastFloor(z);
 	int x1 = x0 + 1;
 	int y1 = y0 + 1;
+	int z1 = z0 + 1;
 
-	FN_DECIMAL xs, ys;
-	switch (m_interp)
+	FN_DECIMAL xs = InterpFunc<interp>(x - (FN_DECIMAL)x0);
+	FN_DECIMAL ys = InterpFunc<interp>(y - (FN_DECIMAL)y0);
+	FN_DECIMAL zs = InterpFunc<interp>(z - (FN_DECIMAL)z0);
+
+	FN_DECIMAL xf00 = Lerp(ValCoord3DFast(offset, x0, y0, z0), ValCoord3DFast(offset, x1, y0, z0), xs);
+	FN_DECIMAL xf10 = Lerp(ValCoord3DFast(offset, x0, y1, z0), ValCoord3DFast(offset, x1, y1, z0), xs);
+	FN_DECIMAL xf01 = Lerp(ValCoord3DFast(offset, x0, y0, z1), ValCoord3DFast(offset, x1, y0, z1), xs);
+	FN_DECIMAL xf11 = Lerp(ValCoord3DFast(offset, x0, y1, z1), ValCoord3DFast(offset, x1, y1, z1), xs);
+
+	FN_DECIMAL yf0 = Lerp(xf00, xf10, ys);
+	FN_DECIMAL yf1 = Lerp(xf01, xf11, ys);
+
+	return Lerp(yf0, yf1, zs);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetValueFractal(FN_DECIMAL x, FN_DECIMAL y) const
+
+{
+	return (this->*ResolveNoise2D(ValueFractal))(x * m_frequency, y * m_frequency);
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	FN_DECIMAL sum = SingleValue<interp>(m_perm[0], x, y);
+	FN_DECIMAL amp = 1;
+	int i = 0;
+
+	while (++i < m_octaves)
 	{
-	case Linear:
-		xs = x - (FN_DECIMAL)x0;
-		ys = y - (FN_DECIMAL)y0;
-		break;
-	case Hermite:
-		xs = InterpHermiteFunc(x - (FN_DECIMAL)x0);
-		ys = InterpHermiteFunc(y - (FN_DECIMAL)y0);
-		break;
-	case Quintic:
-		xs = InterpQuinticFunc(x - (FN_DECIMAL)x0);
-		ys = InterpQuinticFunc(y - (FN_DECIMAL)y0);
-		break;
+		x *= m_lacunarity;
+		y *= m_lacunarity;
+
+		amp *= m_gain;
+		sum += SingleValue<interp>(m_perm[i], x, y) * amp;
+	}
+
+	return sum * m_fractalBounding;
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	FN_DECIMAL sum = FastAbs(SingleValue<interp>(m_perm[0], x, y)) * 2 - 1;
+	FN_DECIMAL amp = 1;
+	int i = 0;
+
+	while (++i < m_octaves)
+	{
+		x *= m_lacunarity;
+		y *= m_lacunarity;
+		amp *= m_gain;
+		sum += (FastAbs(SingleValue<interp>(m_perm[i], x, y)) * 2 - 1) * amp;
+	}
+
+	return sum * m_fractalBounding;
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	FN_DECIMAL sum = 1 - FastAbs(SingleValue<interp>(m_perm[0], x, y));
+	FN_DECIMAL amp = 1;
+	int i = 0;
+
+	while (++i < m_octaves)
+	{
+		x *= m_lacunarity;
+		y *= m_lacunarity;
+
+		amp *= m_gain;
+		sum -= (1 - FastAbs(SingleValue<interp>(m_perm[i], x, y))) * amp;
 	}
 
+	return sum;
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetValue(FN_DECIMAL x, FN_DECIMAL y) const
+
+{
+	return (this->*ResolveNoise2D(Value))(x * m_frequency, y * m_frequency);
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
+{
+	int x0 = FastFloor(x);
+	int y0 = FastFloor(y);
+	int x1 = x0 + 1;
+	int y1 = y0 + 1;
+
+	FN_DECIMAL xs = InterpFunc<interp>(x - (FN_DECIMAL)x0);
+	FN_DECIMAL ys = InterpFunc<interp>(y - (FN_DECIMAL)y0);
+
 	FN_DECIMAL xf0 = Lerp(ValCoord2DFast(offset, x0, y0), ValCoord2DFast(offset, x1, y0), xs);
 	FN_DECIMAL xf1 = Lerp(ValCoord2DFast(offset, x0, y1), ValCoord2DFast(offset, x1, y1), xs);
 
@@ -749,28 +1453,18 @@ FN_DECIMAL FastNoise::SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL
 }
 
 // Perlin Noise
-FN_DECIMAL FastNoise::GetPerlinFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
-{
-	x *= m_frequency;
-	y *= m_frequency;
-	z *= m_frequency;
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetPerlinFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 
-	switch (m_fractalType)
-	{
-	case FBM:
-		return SinglePerlinFractalFBM(x, y, z);
-	case Billow:
-		return SinglePerlinFractalBillow(x, y, z);
-	case RigidMulti:
-		return SinglePerlinFractalRigidMulti(x, y, z);
-	default:
-		return 0;
-	}
+{
+	return (this->*ResolveNoise3D(PerlinFractal))(x * m_frequency, y * m_frequency, z * m_frequency);
 }
 
-FN_DECIMAL FastNoise::SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	FN_DECIMAL sum = SinglePerlin(m_perm[0], x, y, z);
+	FN_DECIMAL sum = SinglePerlin<interp>(m_perm[0], x, y, z);
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -781,15 +1475,17 @@ FN_DECIMAL FastNoise::SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECI
 		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum += SinglePerlin(m_perm[i], x, y, z) * amp;
+		sum += SinglePerlin<interp>(m_perm[i], x, y, z) * amp;
 	}
 
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	FN_DECIMAL sum = FastAbs(SinglePerlin(m_perm[0], x, y, z)) * 2 - 1;
+	FN_DECIMAL sum = FastAbs(SinglePerlin<interp>(m_perm[0], x, y, z)) * 2 - 1;
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -800,15 +1496,17 @@ FN_DECIMAL FastNoise::SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_D
 		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum += (FastAbs(SinglePerlin(m_perm[i], x, y, z)) * 2 - 1) * amp;
+		sum += (FastAbs(SinglePerlin<interp>(m_perm[i], x, y, z)) * 2 - 1) * amp;
 	}
 
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
-	FN_DECIMAL sum = 1 - FastAbs(SinglePerlin(m_perm[0], x, y, z));
+	FN_DECIMAL sum = 1 - FastAbs(SinglePerlin<interp>(m_perm[0], x, y, z));
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -819,18 +1517,22 @@ FN_DECIMAL FastNoise::SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y,
 		z *= m_lacunarity;
 
 		amp *= m_gain;
-		sum -= (1 - FastAbs(SinglePerlin(m_perm[i], x, y, z))) * amp;
+		sum -= (1 - FastAbs(SinglePerlin<interp>(m_perm[i], x, y, z))) * amp;
 	}
 
 	return sum;
 }
 
-FN_DECIMAL FastNoise::GetPerlin(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetPerlin(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+
 {
-	return SinglePerlin(0, x * m_frequency, y * m_frequency, z * m_frequency);
+	return (this->*ResolveNoise3D(Perlin))(x * m_frequency, y * m_frequency, z * m_frequency);
 }
 
-FN_DECIMAL FastNoise::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	int x0 = FastFloor(x);
 	int y0 = FastFloor(y);
@@ -839,25 +1541,9 @@ FN_DECIMAL FastNoise::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMA
 	int y1 = y0 + 1;
 	int z1 = z0 + 1;
 
-	FN_DECIMAL xs, ys, zs;
-	switch (m_interp)
-	{
-	case Linear:
-		xs = x - (FN_DECIMAL)x0;
-		ys = y - (FN_DECIMAL)y0;
-		zs = z - (FN_DECIMAL)z0;
-		break;
-	case Hermite:
-		xs = InterpHermiteFunc(x - (FN_DECIMAL)x0);
-		ys = InterpHermiteFunc(y - (FN_DECIMAL)y0);
-		zs = InterpHermiteFunc(z - (FN_DECIMAL)z0);
-		break;
-	case Quintic:
-		xs = InterpQuinticFunc(x - (FN_DECIMAL)x0);
-		ys = InterpQuinticFunc(y - (FN_DECIMAL)y0);
-		zs = InterpQuinticFunc(z - (FN_DECIMAL)z0);
-		break;
-	}
+	FN_DECIMAL xs = InterpFunc<interp>(x - (FN_DECIMAL)x0);
+	FN_DECIMAL ys = InterpFunc<interp>(y - (FN_DECIMAL)y0);
+	FN_DECIMAL zs = InterpFunc<interp>(z - (FN_DECIMAL)z0);
 
 	FN_DECIMAL xd0 = x - (FN_DECIMAL)x0;
 	FN_DECIMAL yd0 = y - (FN_DECIMAL)y0;
@@ -877,27 +1563,18 @@ FN_DECIMAL FastNoise::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMA
 	return Lerp(yf0, yf1, zs);
 }
 
-FN_DECIMAL FastNoise::GetPerlinFractal(FN_DECIMAL x, FN_DECIMAL y) const
-{
-	x *= m_frequency;
-	y *= m_frequency;
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetPerlinFractal(FN_DECIMAL x, FN_DECIMAL y) const
 
-	switch (m_fractalType)
-	{
-	case FBM:
-		return SinglePerlinFractalFBM(x, y);
-	case Billow:
-		return SinglePerlinFractalBillow(x, y);
-	case RigidMulti:
-		return SinglePerlinFractalRigidMulti(x, y);
-	default:
-		return 0;
-	}
+{
+	return (this->*ResolveNoise2D(PerlinFractal))(x * m_frequency, y * m_frequency);
 }
 
-FN_DECIMAL FastNoise::SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 {
-	FN_DECIMAL sum = SinglePerlin(m_perm[0], x, y);
+	FN_DECIMAL sum = SinglePerlin<interp>(m_perm[0], x, y);
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -907,15 +1584,17 @@ FN_DECIMAL FastNoise::SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 		y *= m_lacunarity;
 
 		amp *= m_gain;
-		sum += SinglePerlin(m_perm[i], x, y) * amp;
+		sum += SinglePerlin<interp>(m_perm[i], x, y) * amp;
 	}
 
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
 {
-	FN_DECIMAL sum = FastAbs(SinglePerlin(m_perm[0], x, y)) * 2 - 1;
+	FN_DECIMAL sum = FastAbs(SinglePerlin<interp>(m_perm[0], x, y)) * 2 - 1;
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -925,15 +1604,17 @@ FN_DECIMAL FastNoise::SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y) cons
 		y *= m_lacunarity;
 
 		amp *= m_gain;
-		sum += (FastAbs(SinglePerlin(m_perm[i], x, y)) * 2 - 1) * amp;
+		sum += (FastAbs(SinglePerlin<interp>(m_perm[i], x, y)) * 2 - 1) * amp;
 	}
 
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
 {
-	FN_DECIMAL sum = 1 - FastAbs(SinglePerlin(m_perm[0], x, y));
+	FN_DECIMAL sum = 1 - FastAbs(SinglePerlin<interp>(m_perm[0], x, y));
 	FN_DECIMAL amp = 1;
 	int i = 0;
 
@@ -943,40 +1624,30 @@ FN_DECIMAL FastNoise::SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y)
 		y *= m_lacunarity;
 
 		amp *= m_gain;
-		sum -= (1 - FastAbs(SinglePerlin(m_perm[i], x, y))) * amp;
+		sum -= (1 - FastAbs(SinglePerlin<interp>(m_perm[i], x, y))) * amp;
 	}
 
 	return sum;
 }
 
-FN_DECIMAL FastNoise::GetPerlin(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetPerlin(FN_DECIMAL x, FN_DECIMAL y) const
+
 {
-	return SinglePerlin(0, x * m_frequency, y * m_frequency);
+	return (this->*ResolveNoise2D(Perlin))(x * m_frequency, y * m_frequency);
 }
 
-FN_DECIMAL FastNoise::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
 {
 	int x0 = FastFloor(x);
 	int y0 = FastFloor(y);
 	int x1 = x0 + 1;
 	int y1 = y0 + 1;
 
-	FN_DECIMAL xs, ys;
-	switch (m_interp)
-	{
-	case Linear:
-		xs = x - (FN_DECIMAL)x0;
-		ys = y - (FN_DECIMAL)y0;
-		break;
-	case Hermite:
-		xs = InterpHermiteFunc(x - (FN_DECIMAL)x0);
-		ys = InterpHermiteFunc(y - (FN_DECIMAL)y0);
-		break;
-	case Quintic:
-		xs = InterpQuinticFunc(x - (FN_DECIMAL)x0);
-		ys = InterpQuinticFunc(y - (FN_DECIMAL)y0);
-		break;
-	}
+	FN_DECIMAL xs = InterpFunc<interp>(x - (FN_DECIMAL)x0);
+	FN_DECIMAL ys = InterpFunc<interp>(y - (FN_DECIMAL)y0);
 
 	FN_DECIMAL xd0 = x - (FN_DECIMAL)x0;
 	FN_DECIMAL yd0 = y - (FN_DECIMAL)y0;
@@ -991,7 +1662,8 @@ FN_DECIMAL FastNoise::SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMA
 
 // Simplex Noise
 
-FN_DECIMAL FastNoise::GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
@@ -1010,7 +1682,8 @@ FN_DECIMAL FastNoise::GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z
 	}
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL sum = SingleSimplex(m_perm[0], x, y, z);
 	FN_DECIMAL amp = 1;
@@ -1029,7 +1702,8 @@ FN_DECIMAL FastNoise::SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DEC
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL sum = FastAbs(SingleSimplex(m_perm[0], x, y, z)) * 2 - 1;
 	FN_DECIMAL amp = 1;
@@ -1048,7 +1722,8 @@ FN_DECIMAL FastNoise::SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL sum = 1 - FastAbs(SingleSimplex(m_perm[0], x, y, z));
 	FN_DECIMAL amp = 1;
@@ -1067,15 +1742,19 @@ FN_DECIMAL FastNoise::SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y,
 	return sum;
 }
 
-FN_DECIMAL FastNoise::GetSimplex(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetSimplex(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	return SingleSimplex(0, x * m_frequency, y * m_frequency, z * m_frequency);
 }
 
-static const FN_DECIMAL F3 = 1 / FN_DECIMAL(3);
-static const FN_DECIMAL G3 = 1 / FN_DECIMAL(6);
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::F3 = 1 / FN_DECIMAL(3);
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::G3 = 1 / FN_DECIMAL(6);
 
-FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL t = (x + y + z) * F3;
 	int i = FastFloor(x + t);
@@ -1172,25 +1851,184 @@ FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIM
 	return 32 * (n0 + n1 + n2 + n3);
 }
 
-FN_DECIMAL FastNoise::GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SimplexBatch3D(const FN_DECIMAL* xs, const FN_DECIMAL* ys, const FN_DECIMAL* zs, FN_DECIMAL* out, size_t count) const
 {
-	x *= m_frequency;
-	y *= m_frequency;
+	FN_DECIMAL xb[NOISE_BLOCK_SIZE], yb[NOISE_BLOCK_SIZE], zb[NOISE_BLOCK_SIZE];
 
-	switch (m_fractalType)
+	for (size_t start = 0; start < count; start += NOISE_BLOCK_SIZE)
 	{
-	case FBM:
-		return SingleSimplexFractalFBM(x, y);
-	case Billow:
-		return SingleSimplexFractalBillow(x, y);
-	case RigidMulti:
+		int blockSize = (int)std::min(count - start, (size_t)NOISE_BLOCK_SIZE);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			xb[i] = xs[start + i] * m_frequency;
+			yb[i] = ys[start + i] * m_frequency;
+			zb[i] = zs[start + i] * m_frequency;
+		}
+
+		SingleSimplexBlock(0, xb, yb, zb, out + start, blockSize);
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::FractalType fractalType>
+void FastNoiseT<FN_DECIMAL>::SimplexFractalBatch3D(const FN_DECIMAL* xs, const FN_DECIMAL* ys, const FN_DECIMAL* zs, FN_DECIMAL* out, size_t count) const
+{
+	FN_DECIMAL xb[NOISE_BLOCK_SIZE], yb[NOISE_BLOCK_SIZE], zb[NOISE_BLOCK_SIZE];
+	FN_DECIMAL sum[NOISE_BLOCK_SIZE], noise[NOISE_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += NOISE_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)NOISE_BLOCK_SIZE);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			xb[i] = xs[start + i] * m_frequency;
+			yb[i] = ys[start + i] * m_frequency;
+			zb[i] = zs[start + i] * m_frequency;
+		}
+
+		SingleSimplexBlock(m_perm[0], xb, yb, zb, sum, blockSize);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			if (fractalType == Billow)
+				sum[i] = FastAbs(sum[i]) * 2 - 1;
+			else if (fractalType == RigidMulti)
+				sum[i] = 1 - FastAbs(sum[i]);
+		}
+
+		FN_DECIMAL amp = 1;
+
+		for (int octave = 1; octave < m_octaves; octave++)
+		{
+			for (int i = 0; i < blockSize; i++)
+			{
+				xb[i] *= m_lacunarity;
+				yb[i] *= m_lacunarity;
+				zb[i] *= m_lacunarity;
+			}
+
+			amp *= m_gain;
+			SingleSimplexBlock(m_perm[octave], xb, yb, zb, noise, blockSize);
+
+			for (int i = 0; i < blockSize; i++)
+			{
+				if (fractalType == FBM)
+					sum[i] += noise[i] * amp;
+				else if (fractalType == Billow)
+					sum[i] += (FastAbs(noise[i]) * 2 - 1) * amp;
+				else
+					sum[i] -= (1 - FastAbs(noise[i])) * amp;
+			}
+		}
+
+		for (int i = 0; i < blockSize; i++)
+			out[start + i] = fractalType == RigidMulti ? sum[i] : sum[i] * m_fractalBounding;
+	}
+}
+
+// SingleSimplex() over a block, the corner ordering is computed with compares instead of branches
+// and only the permutation lookups are left out of the loops the compiler can vectorise
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SingleSimplexBlock(unsigned char offset, const FN_DECIMAL* xs, const FN_DECIMAL* ys, const FN_DECIMAL* zs, FN_DECIMAL* out, int count) const
+{
+	int i0[NOISE_BLOCK_SIZE], j0[NOISE_BLOCK_SIZE], k0[NOISE_BLOCK_SIZE];
+	int i1[NOISE_BLOCK_SIZE], j1[NOISE_BLOCK_SIZE], k1[NOISE_BLOCK_SIZE];
+	int i2[NOISE_BLOCK_SIZE], j2[NOISE_BLOCK_SIZE], k2[NOISE_BLOCK_SIZE];
+	FN_DECIMAL x0[NOISE_BLOCK_SIZE], y0[NOISE_BLOCK_SIZE], z0[NOISE_BLOCK_SIZE];
+	int lut0[NOISE_BLOCK_SIZE], lut1[NOISE_BLOCK_SIZE], lut2[NOISE_BLOCK_SIZE], lut3[NOISE_BLOCK_SIZE];
+
+	for (int n = 0; n < count; n++)
+	{
+		FN_DECIMAL t = (xs[n] + ys[n] + zs[n]) * F3;
+		int i = FastFloor(xs[n] + t);
+		int j = FastFloor(ys[n] + t);
+		int k = FastFloor(zs[n] + t);
+
+		t = (i + j + k) * G3;
+		FN_DECIMAL X0 = i - t;
+		FN_DECIMAL Y0 = j - t;
+		FN_DECIMAL Z0 = k - t;
+
+		x0[n] = xs[n] - X0;
+		y0[n] = ys[n] - Y0;
+		z0[n] = zs[n] - Z0;
+
+		int xy = x0[n] >= y0[n];
+		int yz = y0[n] >= z0[n];
+		int xz = x0[n] >= z0[n];
+
+		i0[n] = i; j0[n] = j; k0[n] = k;
+		i1[n] = xy & (yz | xz);
+		j1[n] = (xy ^ 1) & yz;
+		k1[n] = (yz ^ 1) & ((xy & xz) ^ 1);
+		i2[n] = xy | (yz & xz);
+		j2[n] = (xy ^ 1) | yz;
+		k2[n] = (yz ^ 1) | ((xy | xz) ^ 1);
+	}
+
+	for (int n = 0; n < count; n++)
+	{
+		lut0[n] = Index3D_12(offset, i0[n], j0[n], k0[n]);
+		lut1[n] = Index3D_12(offset, i0[n] + i1[n], j0[n] + j1[n], k0[n] + k1[n]);
+		lut2[n] = Index3D_12(offset, i0[n] + i2[n], j0[n] + j2[n], k0[n] + k2[n]);
+		lut3[n] = Index3D_12(offset, i0[n] + 1, j0[n] + 1, k0[n] + 1);
+	}
+
+	for (int n = 0; n < count; n++)
+	{
+		FN_DECIMAL x1 = x0[n] - i1[n] + G3;
+		FN_DECIMAL y1 = y0[n] - j1[n] + G3;
+		FN_DECIMAL z1 = z0[n] - k1[n] + G3;
+		FN_DECIMAL x2 = x0[n] - i2[n] + 2*G3;
+		FN_DECIMAL y2 = y0[n] - j2[n] + 2*G3;
+		FN_DECIMAL z2 = z0[n] - k2[n] + 2*G3;
+		FN_DECIMAL x3 = x0[n] - 1 + 3*G3;
+		FN_DECIMAL y3 = y0[n] - 1 + 3*G3;
+		FN_DECIMAL z3 = z0[n] - 1 + 3*G3;
+
+		FN_DECIMAL t0 = FN_DECIMAL(0.6) - x0[n]*x0[n] - y0[n]*y0[n] - z0[n]*z0[n];
+		FN_DECIMAL t1 = FN_DECIMAL(0.6) - x1*x1 - y1*y1 - z1*z1;
+		FN_DECIMAL t2 = FN_DECIMAL(0.6) - x2*x2 - y2*y2 - z2*z2;
+		FN_DECIMAL t3 = FN_DECIMAL(0.6) - x3*x3 - y3*y3 - z3*z3;
+
+		FN_DECIMAL s0 = t0 * t0;
+		FN_DECIMAL s1 = t1 * t1;
+		FN_DECIMAL s2 = t2 * t2;
+		FN_DECIMAL s3 = t3 * t3;
+
+		FN_DECIMAL n0 = s0*s0*(x0[n]*GRAD_X[lut0[n]] + y0[n]*GRAD_Y[lut0[n]] + z0[n]*GRAD_Z[lut0[n]]);
+		FN_DECIMAL n1 = s1*s1*(x1*GRAD_X[lut1[n]] + y1*GRAD_Y[lut1[n]] + z1*GRAD_Z[lut1[n]]);
+		FN_DECIMAL n2 = s2*s2*(x2*GRAD_X[lut2[n]] + y2*GRAD_Y[lut2[n]] + z2*GRAD_Z[lut2[n]]);
+		FN_DECIMAL n3 = s3*s3*(x3*GRAD_X[lut3[n]] + y3*GRAD_Y[lut3[n]] + z3*GRAD_Z[lut3[n]]);
+
+		out[n] = 32 * ((t0 < 0 ? 0 : n0) + (t1 < 0 ? 0 : n1) + (t2 < 0 ? 0 : n2) + (t3 < 0 ? 0 : n3));
+	}
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	x *= m_frequency;
+	y *= m_frequency;
+
+	switch (m_fractalType)
+	{
+	case FBM:
+		return SingleSimplexFractalFBM(x, y);
+	case Billow:
+		return SingleSimplexFractalBillow(x, y);
+	case RigidMulti:
 		return SingleSimplexFractalRigidMulti(x, y);
 	default:
 		return 0;
 	}
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = SingleSimplex(m_perm[0], x, y);
 	FN_DECIMAL amp = 1;
@@ -1208,7 +2046,8 @@ FN_DECIMAL FastNoise::SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = FastAbs(SingleSimplex(m_perm[0], x, y)) * 2 - 1;
 	FN_DECIMAL amp = 1;
@@ -1226,7 +2065,8 @@ FN_DECIMAL FastNoise::SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y) con
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = 1 - FastAbs(SingleSimplex(m_perm[0], x, y));
 	FN_DECIMAL amp = 1;
@@ -1244,7 +2084,8 @@ FN_DECIMAL FastNoise::SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y)
 	return sum;
 }
 
-FN_DECIMAL FastNoise::SingleSimplexFractalBlend(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplexFractalBlend(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = SingleSimplex(m_perm[0], x, y);
 	FN_DECIMAL amp = 1;
@@ -1262,7 +2103,8 @@ FN_DECIMAL FastNoise::SingleSimplexFractalBlend(FN_DECIMAL x, FN_DECIMAL y) cons
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::GetSimplex(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetSimplex(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	return SingleSimplex(0, x * m_frequency, y * m_frequency);
 }
@@ -1270,11 +2112,14 @@ FN_DECIMAL FastNoise::GetSimplex(FN_DECIMAL x, FN_DECIMAL y) const
 //static const FN_DECIMAL F2 = 1 / FN_DECIMAL(2);
 //static const FN_DECIMAL G2 = 1 / FN_DECIMAL(4);
 
-static const FN_DECIMAL SQRT3 = FN_DECIMAL(1.7320508075688772935274463415059);
-static const FN_DECIMAL F2 = FN_DECIMAL(0.5) * (SQRT3 - FN_DECIMAL(1.0));
-static const FN_DECIMAL G2 = (FN_DECIMAL(3.0) - SQRT3) / FN_DECIMAL(6.0);
+// sqrt(3) is written out so F2 and G2 are constant initialised
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::F2 = FN_DECIMAL(0.5) * (FN_DECIMAL(1.7320508075688772935274463415059) - FN_DECIMAL(1.0));
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::G2 = (FN_DECIMAL(3.0) - FN_DECIMAL(1.7320508075688772935274463415059)) / FN_DECIMAL(6.0);
 
-FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL t = (x + y) * F2;
 	int i = FastFloor(x + t);
@@ -1331,7 +2176,138 @@ FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIM
 	return 70 * (n0 + n1 + n2);
 }
 
-FN_DECIMAL FastNoise::GetSimplex(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SimplexBatch2D(const FN_DECIMAL* xs, const FN_DECIMAL* ys, FN_DECIMAL* out, size_t count) const
+{
+	FN_DECIMAL xb[NOISE_BLOCK_SIZE], yb[NOISE_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += NOISE_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)NOISE_BLOCK_SIZE);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			xb[i] = xs[start + i] * m_frequency;
+			yb[i] = ys[start + i] * m_frequency;
+		}
+
+		SingleSimplexBlock(0, xb, yb, out + start, blockSize);
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::FractalType fractalType>
+void FastNoiseT<FN_DECIMAL>::SimplexFractalBatch2D(const FN_DECIMAL* xs, const FN_DECIMAL* ys, FN_DECIMAL* out, size_t count) const
+{
+	FN_DECIMAL xb[NOISE_BLOCK_SIZE], yb[NOISE_BLOCK_SIZE];
+	FN_DECIMAL sum[NOISE_BLOCK_SIZE], noise[NOISE_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += NOISE_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)NOISE_BLOCK_SIZE);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			xb[i] = xs[start + i] * m_frequency;
+			yb[i] = ys[start + i] * m_frequency;
+		}
+
+		SingleSimplexBlock(m_perm[0], xb, yb, sum, blockSize);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			if (fractalType == Billow)
+				sum[i] = FastAbs(sum[i]) * 2 - 1;
+			else if (fractalType == RigidMulti)
+				sum[i] = 1 - FastAbs(sum[i]);
+		}
+
+		FN_DECIMAL amp = 1;
+
+		for (int octave = 1; octave < m_octaves; octave++)
+		{
+			for (int i = 0; i < blockSize; i++)
+			{
+				xb[i] *= m_lacunarity;
+				yb[i] *= m_lacunarity;
+			}
+
+			amp *= m_gain;
+			SingleSimplexBlock(m_perm[octave], xb, yb, noise, blockSize);
+
+			for (int i = 0; i < blockSize; i++)
+			{
+				if (fractalType == FBM)
+					sum[i] += noise[i] * amp;
+				else if (fractalType == Billow)
+					sum[i] += (FastAbs(noise[i]) * 2 - 1) * amp;
+				else
+					sum[i] -= (1 - FastAbs(noise[i])) * amp;
+			}
+		}
+
+		for (int i = 0; i < blockSize; i++)
+			out[start + i] = fractalType == RigidMulti ? sum[i] : sum[i] * m_fractalBounding;
+	}
+}
+
+// SingleSimplex() over a block, see the 3D version
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SingleSimplexBlock(unsigned char offset, const FN_DECIMAL* xs, const FN_DECIMAL* ys, FN_DECIMAL* out, int count) const
+{
+	int i0[NOISE_BLOCK_SIZE], j0[NOISE_BLOCK_SIZE], i1[NOISE_BLOCK_SIZE];
+	FN_DECIMAL x0[NOISE_BLOCK_SIZE], y0[NOISE_BLOCK_SIZE];
+	int lut0[NOISE_BLOCK_SIZE], lut1[NOISE_BLOCK_SIZE], lut2[NOISE_BLOCK_SIZE];
+
+	for (int n = 0; n < count; n++)
+	{
+		FN_DECIMAL t = (xs[n] + ys[n]) * F2;
+		int i = FastFloor(xs[n] + t);
+		int j = FastFloor(ys[n] + t);
+
+		t = (i + j) * G2;
+		FN_DECIMAL X0 = i - t;
+		FN_DECIMAL Y0 = j - t;
+
+		x0[n] = xs[n] - X0;
+		y0[n] = ys[n] - Y0;
+
+		i0[n] = i; j0[n] = j;
+		i1[n] = x0[n] > y0[n];
+	}
+
+	for (int n = 0; n < count; n++)
+	{
+		lut0[n] = Index2D_12(offset, i0[n], j0[n]);
+		lut1[n] = Index2D_12(offset, i0[n] + i1[n], j0[n] + (i1[n] ^ 1));
+		lut2[n] = Index2D_12(offset, i0[n] + 1, j0[n] + 1);
+	}
+
+	for (int n = 0; n < count; n++)
+	{
+		FN_DECIMAL x1 = x0[n] - (FN_DECIMAL)i1[n] + G2;
+		FN_DECIMAL y1 = y0[n] - (FN_DECIMAL)(i1[n] ^ 1) + G2;
+		FN_DECIMAL x2 = x0[n] - 1 + 2*G2;
+		FN_DECIMAL y2 = y0[n] - 1 + 2*G2;
+
+		FN_DECIMAL t0 = FN_DECIMAL(0.5) - x0[n]*x0[n] - y0[n]*y0[n];
+		FN_DECIMAL t1 = FN_DECIMAL(0.5) - x1*x1 - y1*y1;
+		FN_DECIMAL t2 = FN_DECIMAL(0.5) - x2*x2 - y2*y2;
+
+		FN_DECIMAL s0 = t0 * t0;
+		FN_DECIMAL s1 = t1 * t1;
+		FN_DECIMAL s2 = t2 * t2;
+
+		FN_DECIMAL n0 = s0*s0*(x0[n]*GRAD_X[lut0[n]] + y0[n]*GRAD_Y[lut0[n]]);
+		FN_DECIMAL n1 = s1*s1*(x1*GRAD_X[lut1[n]] + y1*GRAD_Y[lut1[n]]);
+		FN_DECIMAL n2 = s2*s2*(x2*GRAD_X[lut2[n]] + y2*GRAD_Y[lut2[n]]);
+
+		out[n] = 70 * ((t0 < 0 ? 0 : n0) + (t1 < 0 ? 0 : n1) + (t2 < 0 ? 0 : n2));
+	}
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetSimplex(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
 {
 	return SingleSimplex(0, x * m_frequency, y * m_frequency, z * m_frequency, w * m_frequency);
 }
@@ -1348,10 +2324,13 @@ static const unsigned char SIMPLEX_4D[] =
 	2,1,0,3,0,0,0,0,0,0,0,0,0,0,0,0,3,1,0,2,0,0,0,0,3,2,0,1,3,2,1,0
 };
 
-static const FN_DECIMAL F4 = (sqrt(FN_DECIMAL(5)) - 1) / 4;
-static const FN_DECIMAL G4 = (5 - sqrt(FN_DECIMAL(5))) / 2;
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::F4 = (sqrt(FN_DECIMAL(5)) - 1) / 4;
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::G4 = (5 - sqrt(FN_DECIMAL(5))) / 2;
 
-FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
 {
 	FN_DECIMAL n0, n1, n2, n3, n4;
 	FN_DECIMAL t = (x + y + z + w) * F4;
@@ -1442,7 +2421,8 @@ FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIM
 }
 
 // Cubic Noise
-FN_DECIMAL FastNoise::GetCubicFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetCubicFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
@@ -1461,7 +2441,8 @@ FN_DECIMAL FastNoise::GetCubicFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z)
 	}
 }
 
-FN_DECIMAL FastNoise::SingleCubicFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubicFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL sum = SingleCubic(m_perm[0], x, y, z);
 	FN_DECIMAL amp = 1;
@@ -1480,7 +2461,8 @@ FN_DECIMAL FastNoise::SingleCubicFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIM
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleCubicFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubicFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL sum = FastAbs(SingleCubic(m_perm[0], x, y, z)) * 2 - 1;
 	FN_DECIMAL amp = 1;
@@ -1499,7 +2481,8 @@ FN_DECIMAL FastNoise::SingleCubicFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DE
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleCubicFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubicFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	FN_DECIMAL sum = 1 - FastAbs(SingleCubic(m_perm[0], x, y, z));
 	FN_DECIMAL amp = 1;
@@ -1518,14 +2501,17 @@ FN_DECIMAL FastNoise::SingleCubicFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, F
 	return sum;
 }
 
-FN_DECIMAL FastNoise::GetCubic(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetCubic(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	return SingleCubic(0, x * m_frequency, y * m_frequency, z * m_frequency);
 }
 
-const FN_DECIMAL CUBIC_3D_BOUNDING = 1 / (FN_DECIMAL(1.5) * FN_DECIMAL(1.5) * FN_DECIMAL(1.5));
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CUBIC_3D_BOUNDING = 1 / (FN_DECIMAL(1.5) * FN_DECIMAL(1.5) * FN_DECIMAL(1.5));
 
-FN_DECIMAL FastNoise::SingleCubic(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubic(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	int x1 = FastFloor(x);
 	int y1 = FastFloor(y);
@@ -1574,7 +2560,8 @@ FN_DECIMAL FastNoise::SingleCubic(unsigned char offset, FN_DECIMAL x, FN_DECIMAL
 }
 
 
-FN_DECIMAL FastNoise::GetCubicFractal(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetCubicFractal(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
@@ -1592,7 +2579,8 @@ FN_DECIMAL FastNoise::GetCubicFractal(FN_DECIMAL x, FN_DECIMAL y) const
 	}
 }
 
-FN_DECIMAL FastNoise::SingleCubicFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubicFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = SingleCubic(m_perm[0], x, y);
 	FN_DECIMAL amp = 1;
@@ -1610,7 +2598,8 @@ FN_DECIMAL FastNoise::SingleCubicFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleCubicFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubicFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = FastAbs(SingleCubic(m_perm[0], x, y)) * 2 - 1;
 	FN_DECIMAL amp = 1;
@@ -1628,7 +2617,8 @@ FN_DECIMAL FastNoise::SingleCubicFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const
 	return sum * m_fractalBounding;
 }
 
-FN_DECIMAL FastNoise::SingleCubicFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubicFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	FN_DECIMAL sum = 1 - FastAbs(SingleCubic(m_perm[0], x, y));
 	FN_DECIMAL amp = 1;
@@ -1646,7 +2636,8 @@ FN_DECIMAL FastNoise::SingleCubicFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) c
 	return sum;
 }
 
-FN_DECIMAL FastNoise::GetCubic(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetCubic(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
@@ -1654,9 +2645,11 @@ FN_DECIMAL FastNoise::GetCubic(FN_DECIMAL x, FN_DECIMAL y) const
 	return SingleCubic(0, x, y);
 }
 
-const FN_DECIMAL CUBIC_2D_BOUNDING = 1 / (FN_DECIMAL(1.5) * FN_DECIMAL(1.5));
+template <typename FN_DECIMAL>
+const FN_DECIMAL FastNoiseT<FN_DECIMAL>::CUBIC_2D_BOUNDING = 1 / (FN_DECIMAL(1.5) * FN_DECIMAL(1.5));
 
-FN_DECIMAL FastNoise::SingleCubic(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCubic(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const
 {
 	int x1 = FastFloor(x);
 	int y1 = FastFloor(y);
@@ -1680,7 +2673,8 @@ FN_DECIMAL FastNoise::SingleCubic(unsigned char offset, FN_DECIMAL x, FN_DECIMAL
 }
 
 // Cellular Noise
-FN_DECIMAL FastNoise::GetCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
@@ -1697,7 +2691,8 @@ FN_DECIMAL FastNoise::GetCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) cons
 	}
 }
 
-FN_DECIMAL FastNoise::SingleCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	int xr = FastRound(x);
 	int yr = FastRound(y);
@@ -1794,7 +2789,7 @@ FN_DECIMAL FastNoise::SingleCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) c
 	switch (m_cellularReturnType)
 	{
 	case CellValue:
-		return ValCoord3D(m_seed, xc, yc, zc);
+		return ValCoord3D<FN_DECIMAL>(m_seed, xc, yc, zc);
 
 	case NoiseLookup:
 		assert(m_cellularNoiseLookup);
@@ -1809,7 +2804,8 @@ FN_DECIMAL FastNoise::SingleCellular(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) c
 	}
 }
 
-FN_DECIMAL FastNoise::SingleCellular2Edge(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCellular2Edge(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
 {
 	int xr = FastRound(x);
 	int yr = FastRound(y);
@@ -1906,7 +2902,74 @@ FN_DECIMAL FastNoise::SingleCellular2Edge(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL
 	}
 }
 
-FN_DECIMAL FastNoise::GetCellular(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetCellularAll(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, CellularResult& result) const
+{
+	x *= m_frequency;
+	y *= m_frequency;
+	z *= m_frequency;
+
+	switch (m_cellularDistanceFunction)
+	{
+	case Manhattan:
+		SingleCellularAll<Manhattan>(x, y, z, result);
+		break;
+	case Natural:
+		SingleCellularAll<Natural>(x, y, z, result);
+		break;
+	default:
+		SingleCellularAll<Euclidean>(x, y, z, result);
+		break;
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::CellularDistanceFunction distanceFunction>
+void FastNoiseT<FN_DECIMAL>::SingleCellularAll(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, CellularResult& result) const
+{
+	int xr = FastRound(x);
+	int yr = FastRound(y);
+	int zr = FastRound(z);
+
+	FN_DECIMAL* distance = result.distance;
+	int xc = xr, yc = yr, zc = zr;
+
+	for (int i = 0; i <= FN_CELLULAR_INDEX_MAX; i++)
+		distance[i] = 999999;
+
+	for (int xi = xr - 1; xi <= xr + 1; xi++)
+	{
+		for (int yi = yr - 1; yi <= yr + 1; yi++)
+		{
+			for (int zi = zr - 1; zi <= zr + 1; zi++)
+			{
+				unsigned char lutPos = Index3D_256(0, xi, yi, zi);
+
+				FN_DECIMAL vecX = xi - x + CELL_3D_X[lutPos] * m_cellularJitter;
+				FN_DECIMAL vecY = yi - y + CELL_3D_Y[lutPos] * m_cellularJitter;
+				FN_DECIMAL vecZ = zi - z + CELL_3D_Z[lutPos] * m_cellularJitter;
+
+				FN_DECIMAL newDistance = CellularDistance<distanceFunction>(vecX, vecY, vecZ);
+
+				if (newDistance < distance[0])
+				{
+					xc = xi;
+					yc = yi;
+					zc = zi;
+				}
+
+				for (int i = FN_CELLULAR_INDEX_MAX; i > 0; i--)
+					distance[i] = std::max(std::min(distance[i], newDistance), distance[i - 1]);
+				distance[0] = std::min(distance[0], newDistance);
+			}
+		}
+	}
+
+	result.cellValue = ValCoord3D<FN_DECIMAL>(m_seed, xc, yc, zc);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::GetCellular(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	x *= m_frequency;
 	y *= m_frequency;
@@ -1922,7 +2985,8 @@ FN_DECIMAL FastNoise::GetCellular(FN_DECIMAL x, FN_DECIMAL y) const
 	}
 }
 
-FN_DECIMAL FastNoise::SingleCellular(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCellular(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	int xr = FastRound(x);
 	int yr = FastRound(y);
@@ -2002,7 +3066,7 @@ FN_DECIMAL FastNoise::SingleCellular(FN_DECIMAL x, FN_DECIMAL y) const
 	switch (m_cellularReturnType)
 	{
 	case CellValue:
-		return ValCoord2D(m_seed, xc, yc);
+		return ValCoord2D<FN_DECIMAL>(m_seed, xc, yc);
 
 	case NoiseLookup:
 		assert(m_cellularNoiseLookup);
@@ -2017,7 +3081,8 @@ FN_DECIMAL FastNoise::SingleCellular(FN_DECIMAL x, FN_DECIMAL y) const
 	}
 }
 
-FN_DECIMAL FastNoise::SingleCellular2Edge(FN_DECIMAL x, FN_DECIMAL y) const
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseT<FN_DECIMAL>::SingleCellular2Edge(FN_DECIMAL x, FN_DECIMAL y) const
 {
 	int xr = FastRound(x);
 	int yr = FastRound(y);
@@ -2100,12 +3165,73 @@ FN_DECIMAL FastNoise::SingleCellular2Edge(FN_DECIMAL x, FN_DECIMAL y) const
 	}
 }
 
-void FastNoise::GradientPerturb(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GetCellularAll(FN_DECIMAL x, FN_DECIMAL y, CellularResult& result) const
+{
+	x *= m_frequency;
+	y *= m_frequency;
+
+	switch (m_cellularDistanceFunction)
+	{
+	case Manhattan:
+		SingleCellularAll<Manhattan>(x, y, result);
+		break;
+	case Natural:
+		SingleCellularAll<Natural>(x, y, result);
+		break;
+	default:
+		SingleCellularAll<Euclidean>(x, y, result);
+		break;
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::CellularDistanceFunction distanceFunction>
+void FastNoiseT<FN_DECIMAL>::SingleCellularAll(FN_DECIMAL x, FN_DECIMAL y, CellularResult& result) const
+{
+	int xr = FastRound(x);
+	int yr = FastRound(y);
+
+	FN_DECIMAL* distance = result.distance;
+	int xc = xr, yc = yr;
+
+	for (int i = 0; i <= FN_CELLULAR_INDEX_MAX; i++)
+		distance[i] = 999999;
+
+	for (int xi = xr - 1; xi <= xr + 1; xi++)
+	{
+		for (int yi = yr - 1; yi <= yr + 1; yi++)
+		{
+			unsigned char lutPos = Index2D_256(0, xi, yi);
+
+			FN_DECIMAL vecX = xi - x + CELL_2D_X[lutPos] * m_cellularJitter;
+			FN_DECIMAL vecY = yi - y + CELL_2D_Y[lutPos] * m_cellularJitter;
+
+			FN_DECIMAL newDistance = CellularDistance<distanceFunction>(vecX, vecY);
+
+			if (newDistance < distance[0])
+			{
+				xc = xi;
+				yc = yi;
+			}
+
+			for (int i = FN_CELLULAR_INDEX_MAX; i > 0; i--)
+				distance[i] = std::max(std::min(distance[i], newDistance), distance[i - 1]);
+			distance[0] = std::min(distance[0], newDistance);
+		}
+	}
+
+	result.cellValue = ValCoord2D<FN_DECIMAL>(m_seed, xc, yc);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturb(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const
 {
 	SingleGradientPerturb(0, m_gradientPerturbAmp, m_frequency, x, y, z);
 }
 
-void FastNoise::GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const
 {
 	FN_DECIMAL amp = m_gradientPerturbAmp * m_fractalBounding;
 	FN_DECIMAL freq = m_frequency;
@@ -2121,7 +3247,8 @@ void FastNoise::GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL&
 	}
 }
 
-void FastNoise::SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const
 {
 	FN_DECIMAL xf = x * frequency;
 	FN_DECIMAL yf = y * frequency;
@@ -2192,12 +3319,154 @@ void FastNoise::SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp,
 	z += Lerp(lz0y, Lerp(lz0x, lz1x, ys), zs) * warpAmp;
 }
 
-void FastNoise::GradientPerturb(FN_DECIMAL& x, FN_DECIMAL& y) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturbBatch(FN_DECIMAL* xs, FN_DECIMAL* ys, FN_DECIMAL* zs, size_t count) const
+{
+	switch (m_interp)
+	{
+	case Linear:
+		PerturbBatch<Linear>(false, xs, ys, zs, count);
+		break;
+	case Hermite:
+		PerturbBatch<Hermite>(false, xs, ys, zs, count);
+		break;
+	default:
+		PerturbBatch<Quintic>(false, xs, ys, zs, count);
+		break;
+	}
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturbFractalBatch(FN_DECIMAL* xs, FN_DECIMAL* ys, FN_DECIMAL* zs, size_t count) const
+{
+	switch (m_interp)
+	{
+	case Linear:
+		PerturbBatch<Linear>(true, xs, ys, zs, count);
+		break;
+	case Hermite:
+		PerturbBatch<Hermite>(true, xs, ys, zs, count);
+		break;
+	default:
+		PerturbBatch<Quintic>(true, xs, ys, zs, count);
+		break;
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+void FastNoiseT<FN_DECIMAL>::PerturbBatch(bool fractal, FN_DECIMAL* xs, FN_DECIMAL* ys, FN_DECIMAL* zs, size_t count) const
+{
+	for (size_t start = 0; start < count; start += PERTURB_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)PERTURB_BLOCK_SIZE);
+		FN_DECIMAL* xb = xs + start;
+		FN_DECIMAL* yb = ys + start;
+		FN_DECIMAL* zb = zs + start;
+
+		if (!fractal)
+		{
+			SingleGradientPerturbBlock<interp>(0, m_gradientPerturbAmp, m_frequency, xb, yb, zb, blockSize);
+			continue;
+		}
+
+		FN_DECIMAL amp = m_gradientPerturbAmp * m_fractalBounding;
+		FN_DECIMAL freq = m_frequency;
+		int i = 0;
+
+		SingleGradientPerturbBlock<interp>(m_perm[0], amp, m_frequency, xb, yb, zb, blockSize);
+
+		while (++i < m_octaves)
+		{
+			freq *= m_lacunarity;
+			amp *= m_gain;
+			SingleGradientPerturbBlock<interp>(m_perm[i], amp, freq, xb, yb, zb, blockSize);
+		}
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+void FastNoiseT<FN_DECIMAL>::SingleGradientPerturbBlock(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL* xs, FN_DECIMAL* ys, FN_DECIMAL* zs, int count) const
+{
+	int x0[PERTURB_BLOCK_SIZE], y0[PERTURB_BLOCK_SIZE], z0[PERTURB_BLOCK_SIZE];
+	FN_DECIMAL xi[PERTURB_BLOCK_SIZE], yi[PERTURB_BLOCK_SIZE], zi[PERTURB_BLOCK_SIZE];
+	FN_DECIMAL xw[PERTURB_BLOCK_SIZE], yw[PERTURB_BLOCK_SIZE], zw[PERTURB_BLOCK_SIZE];
+
+	for (int i = 0; i < count; i++)
+	{
+		FN_DECIMAL xf = xs[i] * frequency;
+		FN_DECIMAL yf = ys[i] * frequency;
+		FN_DECIMAL zf = zs[i] * frequency;
+
+		x0[i] = FastFloor(xf);
+		y0[i] = FastFloor(yf);
+		z0[i] = FastFloor(zf);
+
+		xi[i] = InterpFunc<interp>(xf - (FN_DECIMAL)x0[i]);
+		yi[i] = InterpFunc<interp>(yf - (FN_DECIMAL)y0[i]);
+		zi[i] = InterpFunc<interp>(zf - (FN_DECIMAL)z0[i]);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		int x1 = x0[i] + 1;
+		int y1 = y0[i] + 1;
+		int z1 = z0[i] + 1;
+
+		int lutPos0 = Index3D_256(offset, x0[i], y0[i], z0[i]);
+		int lutPos1 = Index3D_256(offset, x1, y0[i], z0[i]);
+
+		FN_DECIMAL lx0x = Lerp(CELL_3D_X[lutPos0], CELL_3D_X[lutPos1], xi[i]);
+		FN_DECIMAL ly0x = Lerp(CELL_3D_Y[lutPos0], CELL_3D_Y[lutPos1], xi[i]);
+		FN_DECIMAL lz0x = Lerp(CELL_3D_Z[lutPos0], CELL_3D_Z[lutPos1], xi[i]);
+
+		lutPos0 = Index3D_256(offset, x0[i], y1, z0[i]);
+		lutPos1 = Index3D_256(offset, x1, y1, z0[i]);
+
+		FN_DECIMAL lx1x = Lerp(CELL_3D_X[lutPos0], CELL_3D_X[lutPos1], xi[i]);
+		FN_DECIMAL ly1x = Lerp(CELL_3D_Y[lutPos0], CELL_3D_Y[lutPos1], xi[i]);
+		FN_DECIMAL lz1x = Lerp(CELL_3D_Z[lutPos0], CELL_3D_Z[lutPos1], xi[i]);
+
+		FN_DECIMAL lx0y = Lerp(lx0x, lx1x, yi[i]);
+		FN_DECIMAL ly0y = Lerp(ly0x, ly1x, yi[i]);
+		FN_DECIMAL lz0y = Lerp(lz0x, lz1x, yi[i]);
+
+		lutPos0 = Index3D_256(offset, x0[i], y0[i], z1);
+		lutPos1 = Index3D_256(offset, x1, y0[i], z1);
+
+		lx0x = Lerp(CELL_3D_X[lutPos0], CELL_3D_X[lutPos1], xi[i]);
+		ly0x = Lerp(CELL_3D_Y[lutPos0], CELL_3D_Y[lutPos1], xi[i]);
+		lz0x = Lerp(CELL_3D_Z[lutPos0], CELL_3D_Z[lutPos1], xi[i]);
+
+		lutPos0 = Index3D_256(offset, x0[i], y1, z1);
+		lutPos1 = Index3D_256(offset, x1, y1, z1);
+
+		lx1x = Lerp(CELL_3D_X[lutPos0], CELL_3D_X[lutPos1], xi[i]);
+		ly1x = Lerp(CELL_3D_Y[lutPos0], CELL_3D_Y[lutPos1], xi[i]);
+		lz1x = Lerp(CELL_3D_Z[lutPos0], CELL_3D_Z[lutPos1], xi[i]);
+
+		xw[i] = Lerp(lx0y, Lerp(lx0x, lx1x, yi[i]), zi[i]);
+		yw[i] = Lerp(ly0y, Lerp(ly0x, ly1x, yi[i]), zi[i]);
+		zw[i] = Lerp(lz0y, Lerp(lz0x, lz1x, yi[i]), zi[i]);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		xs[i] += xw[i] * warpAmp;
+		ys[i] += yw[i] * warpAmp;
+		zs[i] += zw[i] * warpAmp;
+	}
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturb(FN_DECIMAL& x, FN_DECIMAL& y) const
 {
 	SingleGradientPerturb(0, m_gradientPerturbAmp, m_frequency, x, y);
 }
 
-void FastNoise::GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y) const
 {
 	FN_DECIMAL amp = m_gradientPerturbAmp * m_fractalBounding;
 	FN_DECIMAL freq = m_frequency;
@@ -2213,7 +3482,8 @@ void FastNoise::GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y) const
 	}
 }
 
-void FastNoise::SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL& x, FN_DECIMAL& y) const
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL& x, FN_DECIMAL& y) const
 {
 	FN_DECIMAL xf = x * frequency;
 	FN_DECIMAL yf = y * frequency;
@@ -2256,3 +3526,444 @@ void FastNoise::SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp,
 	x += Lerp(lx0x, lx1x, ys) * warpAmp;
 	y += Lerp(ly0x, ly1x, ys) * warpAmp;
 }
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturbBatch(FN_DECIMAL* xs, FN_DECIMAL* ys, size_t count) const
+{
+	switch (m_interp)
+	{
+	case Linear:
+		PerturbBatch<Linear>(false, xs, ys, count);
+		break;
+	case Hermite:
+		PerturbBatch<Hermite>(false, xs, ys, count);
+		break;
+	default:
+		PerturbBatch<Quintic>(false, xs, ys, count);
+		break;
+	}
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseT<FN_DECIMAL>::GradientPerturbFractalBatch(FN_DECIMAL* xs, FN_DECIMAL* ys, size_t count) const
+{
+	switch (m_interp)
+	{
+	case Linear:
+		PerturbBatch<Linear>(true, xs, ys, count);
+		break;
+	case Hermite:
+		PerturbBatch<Hermite>(true, xs, ys, count);
+		break;
+	default:
+		PerturbBatch<Quintic>(true, xs, ys, count);
+		break;
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+void FastNoiseT<FN_DECIMAL>::PerturbBatch(bool fractal, FN_DECIMAL* xs, FN_DECIMAL* ys, size_t count) const
+{
+	for (size_t start = 0; start < count; start += PERTURB_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)PERTURB_BLOCK_SIZE);
+		FN_DECIMAL* xb = xs + start;
+		FN_DECIMAL* yb = ys + start;
+
+		if (!fractal)
+		{
+			SingleGradientPerturbBlock<interp>(0, m_gradientPerturbAmp, m_frequency, xb, yb, blockSize);
+			continue;
+		}
+
+		FN_DECIMAL amp = m_gradientPerturbAmp * m_fractalBounding;
+		FN_DECIMAL freq = m_frequency;
+		int i = 0;
+
+		SingleGradientPerturbBlock<interp>(m_perm[0], amp, m_frequency, xb, yb, blockSize);
+
+		while (++i < m_octaves)
+		{
+			freq *= m_lacunarity;
+			amp *= m_gain;
+			SingleGradientPerturbBlock<interp>(m_perm[i], amp, freq, xb, yb, blockSize);
+		}
+	}
+}
+
+template <typename FN_DECIMAL>
+template <FastNoiseBase::Interp interp>
+void FastNoiseT<FN_DECIMAL>::SingleGradientPerturbBlock(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL* xs, FN_DECIMAL* ys, int count) const
+{
+	int x0[PERTURB_BLOCK_SIZE], y0[PERTURB_BLOCK_SIZE];
+	FN_DECIMAL xi[PERTURB_BLOCK_SIZE], yi[PERTURB_BLOCK_SIZE];
+	FN_DECIMAL xw[PERTURB_BLOCK_SIZE], yw[PERTURB_BLOCK_SIZE];
+
+	for (int i = 0; i < count; i++)
+	{
+		FN_DECIMAL xf = xs[i] * frequency;
+		FN_DECIMAL yf = ys[i] * frequency;
+
+		x0[i] = FastFloor(xf);
+		y0[i] = FastFloor(yf);
+
+		xi[i] = InterpFunc<interp>(xf - (FN_DECIMAL)x0[i]);
+		yi[i] = InterpFunc<interp>(yf - (FN_DECIMAL)y0[i]);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		int x1 = x0[i] + 1;
+		int y1 = y0[i] + 1;
+
+		int lutPos0 = Index2D_256(offset, x0[i], y0[i]);
+		int lutPos1 = Index2D_256(offset, x1, y0[i]);
+
+		FN_DECIMAL lx0x = Lerp(CELL_2D_X[lutPos0], CELL_2D_X[lutPos1], xi[i]);
+		FN_DECIMAL ly0x = Lerp(CELL_2D_Y[lutPos0], CELL_2D_Y[lutPos1], xi[i]);
+
+		lutPos0 = Index2D_256(offset, x0[i], y1);
+		lutPos1 = Index2D_256(offset, x1, y1);
+
+		FN_DECIMAL lx1x = Lerp(CELL_2D_X[lutPos0], CELL_2D_X[lutPos1], xi[i]);
+		FN_DECIMAL ly1x = Lerp(CELL_2D_Y[lutPos0], CELL_2D_Y[lutPos1], xi[i]);
+
+		xw[i] = Lerp(lx0x, lx1x, yi[i]);
+		yw[i] = Lerp(ly0x, ly1x, yi[i]);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		xs[i] += xw[i] * warpAmp;
+		ys[i] += yw[i] * warpAmp;
+	}
+}
+
+// Baked Noise
+template <typename FN_DECIMAL>
+void FastNoiseBakedT<FN_DECIMAL>::Bake(const FastNoiseT<FN_DECIMAL>& noise, FN_DECIMAL xMin, FN_DECIMAL yMin, FN_DECIMAL xMax, FN_DECIMAL yMax, int xSize, int ySize)
+{
+	assert(xSize >= 2 && ySize >= 2);
+	xSize = std::max(xSize, 2);
+	ySize = std::max(ySize, 2);
+
+	m_3D = false;
+	m_xSize = xSize;
+	m_ySize = ySize;
+	m_zSize = 1;
+	m_xMin = xMin;
+	m_yMin = yMin;
+	m_zMin = 0;
+	m_xStep = (xMax - xMin) / (xSize - 1);
+	m_yStep = (yMax - yMin) / (ySize - 1);
+	m_zStep = 1;
+	m_xInvStep = InvStep(m_xStep);
+	m_yInvStep = InvStep(m_yStep);
+	m_zInvStep = 1;
+
+	m_data.resize(size_t(xSize) * ySize);
+
+	int index = 0;
+	for (int x = 0; x < xSize; x++)
+	{
+		FN_DECIMAL xf = xMin + m_xStep * x;
+
+		for (int y = 0; y < ySize; y++)
+			m_data[index++] = noise.GetNoise(xf, yMin + m_yStep * y);
+	}
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseBakedT<FN_DECIMAL>::Bake(const FastNoiseT<FN_DECIMAL>& noise, FN_DECIMAL xMin, FN_DECIMAL yMin, FN_DECIMAL zMin,
+	FN_DECIMAL xMax, FN_DECIMAL yMax, FN_DECIMAL zMax, int xSize, int ySize, int zSize)
+{
+	assert(xSize >= 2 && ySize >= 2 && zSize >= 2);
+	xSize = std::max(xSize, 2);
+	ySize = std::max(ySize, 2);
+	zSize = std::max(zSize, 2);
+
+	m_3D = true;
+	m_xSize = xSize;
+	m_ySize = ySize;
+	m_zSize = zSize;
+	m_xMin = xMin;
+	m_yMin = yMin;
+	m_zMin = zMin;
+	m_xStep = (xMax - xMin) / (xSize - 1);
+	m_yStep = (yMax - yMin) / (ySize - 1);
+	m_zStep = (zMax - zMin) / (zSize - 1);
+	m_xInvStep = InvStep(m_xStep);
+	m_yInvStep = InvStep(m_yStep);
+	m_zInvStep = InvStep(m_zStep);
+
+	m_data.resize(size_t(xSize) * ySize * zSize);
+
+	int index = 0;
+	for (int x = 0; x < xSize; x++)
+	{
+		FN_DECIMAL xf = xMin + m_xStep * x;
+
+		for (int y = 0; y < ySize; y++)
+		{
+			FN_DECIMAL yf = yMin + m_yStep * y;
+
+			for (int z = 0; z < zSize; z++)
+				m_data[index++] = noise.GetNoise(xf, yf, zMin + m_zStep * z);
+		}
+	}
+}
+
+template <typename FN_DECIMAL>
+int FastNoiseBakedT<FN_DECIMAL>::GridCell(FN_DECIMAL v, FN_DECIMAL min, FN_DECIMAL invStep, int size, FN_DECIMAL& t)
+{
+	// Written as compares so NaN clamps to 0 instead of reaching the int conversion
+	FN_DECIMAL f = (v - min) * invStep;
+	f = f > 0 ? f : 0;
+	f = f < FN_DECIMAL(size - 1) ? f : FN_DECIMAL(size - 1);
+
+	int i = std::min((int)f, size - 2);
+	t = f - (FN_DECIMAL)i;
+	return i;
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::BorderCubic(FN_DECIMAL a, FN_DECIMAL b, FN_DECIMAL c, FN_DECIMAL d, bool hasA, bool hasD, FN_DECIMAL t)
+{
+	// Quadratic extrapolation keeps border cells third order, linear when only b and c exist
+	// Selects rather than branches so batches stay branch free
+	FN_DECIMAL aOut = hasD ? 3 * (b - c) + d : 2 * b - c;
+	FN_DECIMAL dOut = hasA ? 3 * (c - b) + a : 2 * c - b;
+	a = hasA ? a : aOut;
+	d = hasD ? d : dOut;
+
+	return CatmullRom(a, b, c, d, t);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::CubicRow(int x, int y, int z, FN_DECIMAL t) const
+{
+	return BorderCubic(
+		Sample(std::max(x - 1, 0), y, z),
+		Sample(x, y, z),
+		Sample(x + 1, y, z),
+		Sample(std::min(x + 2, m_xSize - 1), y, z), x > 0, x + 2 < m_xSize, t);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::GetNoise(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	assert(!m_3D && !m_data.empty());
+
+	return m_filter == Linear ? LinearNoise(x, y) : CubicNoise(x, y);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::LinearNoise(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	FN_DECIMAL xs, ys;
+	int x0 = GridCell(x, m_xMin, m_xInvStep, m_xSize, xs);
+	int y0 = GridCell(y, m_yMin, m_yInvStep, m_ySize, ys);
+
+	return Lerp(
+		Lerp(Sample(x0, y0, 0), Sample(x0 + 1, y0, 0), xs),
+		Lerp(Sample(x0, y0 + 1, 0), Sample(x0 + 1, y0 + 1, 0), xs), ys);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::CubicNoise(FN_DECIMAL x, FN_DECIMAL y) const
+{
+	FN_DECIMAL xs, ys;
+	int x0 = GridCell(x, m_xMin, m_xInvStep, m_xSize, xs);
+	int y0 = GridCell(y, m_yMin, m_yInvStep, m_ySize, ys);
+	int y1 = y0 + 1;
+	return BorderCubic(
+		CubicRow(x0, std::max(y0 - 1, 0), 0, xs),
+		CubicRow(x0, y0, 0, xs),
+		CubicRow(x0, y1, 0, xs),
+		CubicRow(x0, std::min(y1 + 1, m_ySize - 1), 0, xs), y0 > 0, y1 + 1 < m_ySize, ys);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::GetNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+{
+	assert(m_3D && !m_data.empty());
+
+	return m_filter == Linear ? LinearNoise(x, y, z) : CubicNoise(x, y, z);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::LinearNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+{
+	FN_DECIMAL xs, ys, zs;
+	int x0 = GridCell(x, m_xMin, m_xInvStep, m_xSize, xs);
+	int y0 = GridCell(y, m_yMin, m_yInvStep, m_ySize, ys);
+	int z0 = GridCell(z, m_zMin, m_zInvStep, m_zSize, zs);
+	int x1 = x0 + 1;
+	int y1 = y0 + 1;
+	int z1 = z0 + 1;
+
+	FN_DECIMAL lz0 = Lerp(
+		Lerp(Sample(x0, y0, z0), Sample(x1, y0, z0), xs),
+		Lerp(Sample(x0, y1, z0), Sample(x1, y1, z0), xs), ys);
+	FN_DECIMAL lz1 = Lerp(
+		Lerp(Sample(x0, y0, z1), Sample(x1, y0, z1), xs),
+		Lerp(Sample(x0, y1, z1), Sample(x1, y1, z1), xs), ys);
+
+	return Lerp(lz0, lz1, zs);
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::CubicNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const
+{
+	FN_DECIMAL xs, ys, zs;
+	int x0 = GridCell(x, m_xMin, m_xInvStep, m_xSize, xs);
+	int y0 = GridCell(y, m_yMin, m_yInvStep, m_ySize, ys);
+	int z0 = GridCell(z, m_zMin, m_zInvStep, m_zSize, zs);
+	int y1 = y0 + 1;
+	int z1 = z0 + 1;
+
+	int yi[4] = { std::max(y0 - 1, 0), y0, y1, std::min(y1 + 1, m_ySize - 1) };
+	int zi[4] = { std::max(z0 - 1, 0), z0, z1, std::min(z1 + 1, m_zSize - 1) };
+	FN_DECIMAL planes[4];
+
+	for (int z = 0; z < 4; z++)
+	{
+		planes[z] = BorderCubic(
+			CubicRow(x0, yi[0], zi[z], xs),
+			CubicRow(x0, yi[1], zi[z], xs),
+			CubicRow(x0, yi[2], zi[z], xs),
+			CubicRow(x0, yi[3], zi[z], xs), y0 > 0, y1 + 1 < m_ySize, ys);
+	}
+
+	return BorderCubic(planes[0], planes[1], planes[2], planes[3], z0 > 0, z1 + 1 < m_zSize, zs);
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseBakedT<FN_DECIMAL>::GetNoiseBatch(const FN_DECIMAL* xs, const FN_DECIMAL* ys, FN_DECIMAL* out, size_t count) const
+{
+	assert(!m_3D && !m_data.empty());
+
+	if (m_filter == Linear)
+	{
+		LinearBatch(xs, ys, out, count);
+	}
+	else
+	{
+		for (size_t i = 0; i < count; i++)
+			out[i] = CubicNoise(xs[i], ys[i]);
+	}
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseBakedT<FN_DECIMAL>::GetNoiseBatch(const FN_DECIMAL* xs, const FN_DECIMAL* ys, const FN_DECIMAL* zs, FN_DECIMAL* out, size_t count) const
+{
+	assert(m_3D && !m_data.empty());
+
+	if (m_filter == Linear)
+	{
+		LinearBatch(xs, ys, zs, out, count);
+	}
+	else
+	{
+		for (size_t i = 0; i < count; i++)
+			out[i] = CubicNoise(xs[i], ys[i], zs[i]);
+	}
+}
+
+// LinearNoise() over blocks, the grid cells of a block are found in one loop the compiler can vectorise
+// and interpolated in a second loop
+template <typename FN_DECIMAL>
+void FastNoiseBakedT<FN_DECIMAL>::LinearBatch(const FN_DECIMAL* xs, const FN_DECIMAL* ys, FN_DECIMAL* out, size_t count) const
+{
+	int cell[BAKED_BLOCK_SIZE];
+	FN_DECIMAL xt[BAKED_BLOCK_SIZE], yt[BAKED_BLOCK_SIZE];
+	const FN_DECIMAL* data = m_data.data();
+	int xStride = m_ySize;
+
+	for (size_t start = 0; start < count; start += BAKED_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)BAKED_BLOCK_SIZE);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			int x0 = GridCell(xs[start + i], m_xMin, m_xInvStep, m_xSize, xt[i]);
+			int y0 = GridCell(ys[start + i], m_yMin, m_yInvStep, m_ySize, yt[i]);
+			cell[i] = x0 * xStride + y0;
+		}
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			const FN_DECIMAL* c = data + cell[i];
+
+			out[start + i] = Lerp(
+				Lerp(c[0], c[xStride], xt[i]),
+				Lerp(c[1], c[xStride + 1], xt[i]), yt[i]);
+		}
+	}
+}
+
+template <typename FN_DECIMAL>
+void FastNoiseBakedT<FN_DECIMAL>::LinearBatch(const FN_DECIMAL* xs, const FN_DECIMAL* ys, const FN_DECIMAL* zs, FN_DECIMAL* out, size_t count) const
+{
+	int cell[BAKED_BLOCK_SIZE];
+	FN_DECIMAL xt[BAKED_BLOCK_SIZE], yt[BAKED_BLOCK_SIZE], zt[BAKED_BLOCK_SIZE];
+	const FN_DECIMAL* data = m_data.data();
+	int xStride = m_ySize * m_zSize;
+	int yStride = m_zSize;
+
+	for (size_t start = 0; start < count; start += BAKED_BLOCK_SIZE)
+	{
+		int blockSize = (int)std::min(count - start, (size_t)BAKED_BLOCK_SIZE);
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			int x0 = GridCell(xs[start + i], m_xMin, m_xInvStep, m_xSize, xt[i]);
+			int y0 = GridCell(ys[start + i], m_yMin, m_yInvStep, m_ySize, yt[i]);
+			int z0 = GridCell(zs[start + i], m_zMin, m_zInvStep, m_zSize, zt[i]);
+			cell[i] = x0 * xStride + y0 * yStride + z0;
+		}
+
+		for (int i = 0; i < blockSize; i++)
+		{
+			const FN_DECIMAL* c = data + cell[i];
+
+			FN_DECIMAL lz0 = Lerp(
+				Lerp(c[0], c[xStride], xt[i]),
+				Lerp(c[yStride], c[xStride + yStride], xt[i]), yt[i]);
+			FN_DECIMAL lz1 = Lerp(
+				Lerp(c[1], c[xStride + 1], xt[i]),
+				Lerp(c[yStride + 1], c[xStride + yStride + 1], xt[i]), yt[i]);
+
+			out[start + i] = Lerp(lz0, lz1, zt[i]);
+		}
+	}
+}
+
+template <typename FN_DECIMAL>
+FN_DECIMAL FastNoiseBakedT<FN_DECIMAL>::MeasureError(const FastNoiseT<FN_DECIMAL>& noise, int sampleCount, int seed) const
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<FN_DECIMAL> unit(0, 1);
+	FN_DECIMAL maxError = 0;
+
+	for (int i = 0; i < sampleCount; i++)
+	{
+		FN_DECIMAL x = m_xMin + m_xStep * (m_xSize - 1) * unit(gen);
+		FN_DECIMAL y = m_yMin + m_yStep * (m_ySize - 1) * unit(gen);
+
+		if (m_3D)
+		{
+			FN_DECIMAL z = m_zMin + m_zStep * (m_zSize - 1) * unit(gen);
+			maxError = std::max(maxError, FastAbs(GetNoise(x, y, z) - noise.GetNoise(x, y, z)));
+		}
+		else
+			maxError = std::max(maxError, FastAbs(GetNoise(x, y) - noise.GetNoise(x, y)));
+	}
+	return maxError;
+}
+
+template class FastNoiseT<float>;
+template class FastNoiseT<double>;
+template class FastNoiseBakedT<float>;
+template class FastNoiseBakedT<double>;